@@ -1,6 +1,14 @@
 #include <OctoWS2811.h>
 #include <OctoWS2811Draw.h>
 #include <game.h>
+#include <inputlog.h>
+#include <interceptcontroller.h>
+#include <scenemachine.h>
+#include <scheduler.h>
+#include <framepacer.h>
+#include <arena.h>
+#include <analoginput.h>
+#include <inputevents.h>
 
 // Set up LED display
 #define HORIZONTAL_RESOLUTION 56
@@ -18,9 +26,6 @@ OctoWS2811Draw draw(&leds, HORIZONTAL_RESOLUTION, VERTICAL_RESOLUTION);
 // Set up game
 // The first to 3 points wins
 #define WINNING_SCORE 3
-#define PHYSICS_TO_PIXEL_RATIO 1
-#define HORIZONTAL_WALL_LENGTH 55
-#define VERTICAL_WALL_HEIGHT 3
 #define PLAYER_LENGTH 1
 #define PLAYER_HEIGHT 5
 #define PLAYER_MAX_MOVE_SPEED 100.0f
@@ -28,7 +33,18 @@ OctoWS2811Draw draw(&leds, HORIZONTAL_RESOLUTION, VERTICAL_RESOLUTION);
 #define BALL_FINAL_ROUND_SPEED 25.0f
 #define BALL_MAX_SPEED 140.0f
 #define BALL_INCREASE_SPEED_INTERVAL 2.5f
-Game game(HORIZONTAL_RESOLUTION, VERTICAL_RESOLUTION, PHYSICS_TO_PIXEL_RATIO);
+#define MULTI_BALL_COUNT 8
+// 1 takes the walls, spawns and ball tuning from the arena blob in classicarena.h, read straight from flash
+#define USE_ARENA 0
+#if USE_ARENA
+#include "classicarena.h"
+typedef ArenaCourtConfig CourtConfig;
+#else
+typedef ClassicCourtConfig CourtConfig;
+#endif
+
+// The court, screen and player and ball counts are fixed by the configuration, so the physics loops compile to their real sizes
+BasicGame<CourtConfig> game;
 
 // Set up controllers
 #define NUM_PLAYERS 4
@@ -37,33 +53,76 @@ Game game(HORIZONTAL_RESOLUTION, VERTICAL_RESOLUTION, PHYSICS_TO_PIXEL_RATIO);
 #define PLAYER_3_PIN 19
 #define PLAYER_4_PIN 22
 PlayerController controller[NUM_PLAYERS];
+
+// Bit i set has the computer play player i instead of its knob, e.g. 2 for a one player game against the right paddle
+#define COMPUTER_PLAYERS 0
+BasicInterceptController<CourtConfig> computerController[NUM_PLAYERS];
 const int playerPin[NUM_PLAYERS] = {PLAYER_1_PIN, PLAYER_2_PIN, PLAYER_4_PIN, PLAYER_3_PIN};
 
+// Knobs are sampled at the input rate into AnalogInput, which filters them and predicts where each will be when the next physics step ends
+class KnobSource : public AnalogSource {
+public:
+	int read(int channel) {
+		return analogRead(playerPin[channel]);
+	}
+};
+KnobSource knobSource;
+AnalogInput knobs(&knobSource, NUM_PLAYERS);
+
 // Set up player colors
 const char* TEAM_1_COLOR = "GREEN";
 const char* TEAM_2_COLOR = "WHITE";
 const int playerColor[NUM_PLAYERS] = {GREEN, WHITE, WHITE, GREEN};
 
-// Run the game at 60FPS
-const float REFRESH_RATE = 1000.0f/60.0f;
-unsigned long lastRefresh;
-const float frameRate = 1.0f/60.0f;
+// The loop is split into tasks that each run at their own rate, in microseconds: knobs are read at 500Hz,
+// and the button, the game and its scenes move on at the physics rate
+#define INPUT_PERIOD (1000000 / 500)
+#define PHYSICS_PERIOD (1000000 / PHYSICS_STEP_RATE)
+Scheduler scheduler(micros);
+
+// Everything is drawn at 60FPS, on time to the microsecond and ahead of the other tasks;
+// set ALIGN_FRAMES_TO_DISPLAY to 0 to start frames on the clock alone, even while the LEDs are still being sent the last one
+#define FRAME_RATE 60
+#define ALIGN_FRAMES_TO_DISPLAY 1
+FramePacer pacer(FRAME_RATE);
+
+// Paddles are asked to close the gap to where their knob is headed over this long, however often the knobs are read
+#define PADDLE_RESPONSE_TIME (1.0f / 60)
+
+// Set to 1 to print each task's run count, deadline misses and runtimes over USB serial every few seconds
+#define PRINT_TASK_STATS 0
+#define TASK_STATS_PERIOD 5000000
 
-// Button
+// Button; its interrupt only queues each edge with the time it happened, and the loop debounces them
 #define BUTTON_PIN 23
-const int debounceTime = 10000;
-volatile unsigned long lastTime;
-volatile bool buttonPressed;
+InputEdgeQueue buttonEdges;
+ButtonDebouncer button;
+
+// Presses this soon after one that was acted on are ignored, in microseconds
+#define BUTTON_LOCKOUT 600000
+unsigned long lastButtonAction;
 
 // States
 enum State {
 	MAIN_MENU,
 	TWO_PLAYERS,
-	FOUR_PLAYERS
+	FOUR_PLAYERS,
+	MULTI_BALL
 };
 
 State state;
-void (*update)(float);
+
+// Scenes a match moves through; each runs a frame at a time, so input, drawing and sound keep going through every transition
+enum SceneId {
+	SCENE_MENU,
+	SCENE_COUNTDOWN,
+	SCENE_RALLY,
+	SCENE_SCORE,
+	SCENE_FINAL_SCORE,
+	SCENE_FINAL_ROUND,
+	SCENE_WIN
+};
+SceneMachine scenes;
 
 // Boundary changes colors
 #define NORMAL_BOUNDARY_CHANGE_COLOR_SPEED 100.0f
@@ -78,10 +137,30 @@ const uint32_t boundaryColors[5] = {0x992099, // pink
 0x999920, // yellow
 0x209999}; // blue
 int currentBoundaryColor;
+Prng colorRandom;
 
 #define INITIAL_START_DELAY 5.0f
 #define ROUND_START_DELAY 2.0f
 
+// How long the last frame of a point stays up, then how long the score, final round and win screens show
+#define POINT_HOLD_TIME 0.5f
+#define SCORE_TIME 2.0f
+#define FINAL_ROUND_TIME 2.0f
+#define WIN_TIME 5.0f
+
+// Set to 1 to stream an input log of everything played over USB serial, for replaying on a PC with extras/input_replay
+#define RECORD_INPUT 0
+#if RECORD_INPUT
+class SerialLogWriter : public InputLogWriter {
+public:
+	void write(const void* data, int size) {
+		Serial.write((const uint8_t*)data, size);
+	}
+};
+SerialLogWriter serialLog;
+InputRecorder recorder(&serialLog);
+#endif
+
 // Audio
 #define BUZZER_PIN 12
 
@@ -92,32 +171,7 @@ void setup() {
 	
 	GameSettings settings;
 
-	// Set up bounds
-	// Floor
-	settings.horizontalWallPoints[0] = physics::vector2d(0, 0);
-
-	// Ceiling
-	settings.horizontalWallPoints[1] = physics::vector2d(0, 23);
-	
-	for (int i = 0; i < 2; ++i) {
-		settings.horizontalWallLengths[i] = HORIZONTAL_WALL_LENGTH;
-	}
-
-	// Bottom left wall
-	settings.verticalWallPoints[0] = physics::vector2d(0, 0);
-
-	// Top left wall
-	settings.verticalWallPoints[1] = physics::vector2d(0, 23 - VERTICAL_WALL_HEIGHT);
-
-	// Bottom right wall
-	settings.verticalWallPoints[2] = physics::vector2d(55, 0);
-
-	// Top right wall
-	settings.verticalWallPoints[3] = physics::vector2d(55, 23 - VERTICAL_WALL_HEIGHT);
-	
-	for (int i = 0; i < 4; ++i) {
-		settings.verticalWallLengths[i] = VERTICAL_WALL_HEIGHT;
-	}
+	// The walls come from ClassicCourtConfig
 
 	// Set up players
 	// Player 1
@@ -139,6 +193,7 @@ void setup() {
 	}
 	
 	// Set up ball
+	settings.numBalls = 1;
 	settings.ballInitialPoint = physics::vector2d(26, 11);
 	settings.ballDiameter = 2;
 	settings.ballInitialVelocity = physics::vector2d(BALL_INITIAL_SPEED, BALL_INITIAL_SPEED);
@@ -151,32 +206,71 @@ void setup() {
 	
 	// Wait time before ball starts moving at start of round
 	settings.startDelay = ROUND_START_DELAY;
+
+#if USE_ARENA
+	// Without a sound arena the game still gets the classic court's walls
+	Arena arena;
+	if (arena.load(classicArena, sizeof(classicArena)) == ARENA_OK) {
+		arena.apply(settings);
+	} else {
+		ClassicCourtConfig::applyCourt(settings);
+	}
+#endif
 	
 	// Init game with settings
 	game.setup(settings);
 
 	// Assign controllers to players
-	game.assignController(0, &controller[0]);
-	game.assignController(1, &controller[1]);
-	game.assignController(2, &controller[2]);
-	game.assignController(3, &controller[3]);
+	for (int i = 0; i < NUM_PLAYERS; ++i) {
+		if (COMPUTER_PLAYERS & (1 << i)) {
+			computerController[i].bind(&game, i);
+			computerController[i].seed(micros() + i);
+			game.assignController(i, &computerController[i]);
+		} else {
+			game.assignController(i, &controller[i]);
+		}
+	}
 
 	// Disable player 3 & 4
 	game.deactivatePlayer(2);
 	game.deactivatePlayer(3);
-	
-	// Callbacks for audio
-	game.setBallCollidesWithWall(playLowBeep);
-	game.setBallCollidesWithPaddle(playHighBeep);
+
+	// A knob's full turn covers the court from floor to ceiling
+	knobs.setRange(0, VERTICAL_RESOLUTION - 1);
+	knobs.setResponseTime(PADDLE_RESPONSE_TIME);
+
+#if RECORD_INPUT || PRINT_TASK_STATS
+	Serial.begin(115200);
+#endif
+#if RECORD_INPUT
+	game.record(&recorder);
+#endif
 	
 	// Button
 	pinMode(BUTTON_PIN, INPUT);
-	lastTime = 0;
-	buttonPressed = false;
-	attachInterrupt(BUTTON_PIN, isrButton, FALLING);
+	attachInterrupt(BUTTON_PIN, isrButton, CHANGE);
+	lastButtonAction = micros() - BUTTON_LOCKOUT;
+
+	// Scenes
+	scenes.addScene(SCENE_MENU, enterMainMenu, 0);
+	scenes.addScene(SCENE_COUNTDOWN, enterCountdown, updateCountdown);
+	scenes.addScene(SCENE_RALLY, 0, updateRally);
+	scenes.addScene(SCENE_SCORE, enterScore, 0, POINT_HOLD_TIME + SCORE_TIME, SCENE_COUNTDOWN);
+	scenes.addScene(SCENE_FINAL_SCORE, enterScore, 0, POINT_HOLD_TIME + SCORE_TIME, SCENE_FINAL_ROUND);
+	scenes.addScene(SCENE_FINAL_ROUND, enterFinalRound, 0, FINAL_ROUND_TIME, SCENE_COUNTDOWN);
+	scenes.addScene(SCENE_WIN, 0, 0, POINT_HOLD_TIME + WIN_TIME, SCENE_MENU);
+
+	// Tasks, most urgent first when their deadlines tie
+	scheduler.addTask(readInput, INPUT_PERIOD);
+	scheduler.addTask(updateScenes, PHYSICS_PERIOD);
+	pacer.setAlignment(ALIGN_FRAMES_TO_DISPLAY);
+	pacer.start(micros());
+#if PRINT_TASK_STATS
+	scheduler.addTask(printTaskStats, TASK_STATS_PERIOD);
+#endif
 	
 	// Initial state is main menu
-	goToMainMenu();
+	scenes.change(SCENE_MENU);
 	
 	// Set up boundary color
 	boundR = 50;
@@ -185,34 +279,26 @@ void setup() {
 	currentBoundaryColor = 0;
 }
 
+// The IR receiver picks up some false positives, but they're shorter than the debounce time
 void isrButton() {
-	noInterrupts();
-	unsigned long time = micros();
-	if (time - lastTime >= debounceTime) {
-		lastTime = time;
-		// Since the IR receiver can pick up some false positives
-		if (digitalRead(BUTTON_PIN) == 0) {
-			buttonPressed = true;
-		}
-	}
-	interrupts();
+	buttonEdges.push(0, digitalRead(BUTTON_PIN) == 0, micros());
 }
 
-void goToMainMenu() {
+void enterMainMenu() {
 	state = MAIN_MENU;
-	update = updateMainMenu;
+	game.changeNumberOfBalls(1);
 }
 
 void goToTwoPlayers() {
 	state = TWO_PLAYERS;
 	boundaryChangeColorSpeed = NORMAL_BOUNDARY_CHANGE_COLOR_SPEED;
 	game.changeBallInitialVelocity(physics::vector2d(BALL_INITIAL_SPEED, BALL_INITIAL_SPEED));
+	game.changeNumberOfBalls(1);
 	game.resetScore();
-	game.resetPlayersAndBall();
 	game.deactivatePlayer(2);
 	game.deactivatePlayer(3);
 	game.changeStartDelay(INITIAL_START_DELAY);
-	update = updateGame;
+	scenes.change(SCENE_COUNTDOWN);
 }
 
 void goToFourPlayers() {
@@ -220,110 +306,211 @@ void goToFourPlayers() {
 	boundaryChangeColorSpeed = NORMAL_BOUNDARY_CHANGE_COLOR_SPEED;
 	game.changeBallInitialVelocity(physics::vector2d(BALL_INITIAL_SPEED, BALL_INITIAL_SPEED));
 	game.resetScore();
-	game.resetPlayersAndBall();
 	game.activatePlayer(2);
 	game.activatePlayer(3);
 	game.changeStartDelay(INITIAL_START_DELAY);
-	update = updateGame;
+	scenes.change(SCENE_COUNTDOWN);
+}
+
+void goToMultiBall() {
+	state = MULTI_BALL;
+	boundaryChangeColorSpeed = NORMAL_BOUNDARY_CHANGE_COLOR_SPEED;
+	game.changeBallInitialVelocity(physics::vector2d(BALL_INITIAL_SPEED, BALL_INITIAL_SPEED));
+	game.changeNumberOfBalls(MULTI_BALL_COUNT);
+	game.resetScore();
+	game.deactivatePlayer(2);
+	game.deactivatePlayer(3);
+	game.changeStartDelay(INITIAL_START_DELAY);
+	scenes.change(SCENE_COUNTDOWN);
 }
 
 void loop() {
-	// Handle button pressed
-	if (buttonPressed) {
-		// Let's still make sure we don't hit the button more than once at a time
-		delay(600);
-		buttonPressed = false;
-		switch (state) {
-			case MAIN_MENU:
-				goToTwoPlayers();
-				break;
-			case TWO_PLAYERS:
-				goToFourPlayers();
-				break;
-			case FOUR_PLAYERS:
-				goToMainMenu();
+#if ALIGN_FRAMES_TO_DISPLAY
+	if (!leds.busy()) {
+		pacer.displayFinished(leds.completedAt());
+	}
+#endif
+	if (pacer.frameDue(micros())) {
+		render(pacer.frameTime());
+	} else {
+		scheduler.runNext();
+	}
+}
+
+// Takes the button's edges queued since the last tick, acting on each debounced press in turn
+void readButton() {
+	// Read before the edges are taken, so any edge still queued came after it
+	unsigned long now = micros();
+	InputEdge edge;
+	while (buttonEdges.pop(edge)) {
+		buttonEvent(button.edge(edge));
+	}
+	buttonEvent(button.settle(now));
+}
+
+// Handle button pressed, ignoring presses that come too soon after the last acted on so the menu isn't skipped through
+void buttonEvent(const ButtonEvent& event) {
+	if (event.type != BUTTON_PRESSED || event.time - lastButtonAction < BUTTON_LOCKOUT) {
+		return;
+	}
+	lastButtonAction = event.time;
+
+	// How long people take to press the button is as good a seed as any
+	game.seed(event.time);
+	colorRandom.setSeed(event.time);
+#if RECORD_INPUT
+	recorder.button(state);
+#endif
+	switch (state) {
+		case MAIN_MENU:
+			goToTwoPlayers();
+			break;
+		case TWO_PLAYERS:
+			goToFourPlayers();
+			break;
+		case FOUR_PLAYERS:
+			goToMultiBall();
+			break;
+		case MULTI_BALL:
+			scenes.change(SCENE_MENU);
+	}
+}
+
+// Samples the knobs and moves the computer players; done whatever scene is up
+void readInput(float dt) {
+	knobs.sample(micros());
+	for (int i = 0; i < NUM_PLAYERS; ++i) {
+		if (COMPUTER_PLAYERS & (1 << i)) {
+			computerController[i].update(dt);
 		}
 	}
+}
 
-	unsigned long now = millis();
-	if ((now - lastRefresh) >= REFRESH_RATE) {
-		lastRefresh= now;
-		update(frameRate);
+// Sets each knob player's speed to bring their paddle to where the knob will be at the end of the coming physics step
+void steerPaddles() {
+	knobs.update();
+	unsigned long stepEnd = micros() + PHYSICS_PERIOD;
+	for (int i = 0; i < NUM_PLAYERS; ++i) {
+		if (!(COMPUTER_PLAYERS & (1 << i)) && game.playerIsActive(i)) {
+			float paddlePosition = physics::toFloat(game.getPlayer(i).getPaddle()->getPosition().y);
+			knobs.steer(i, paddlePosition, stepEnd, controller[i]);
+		}
 	}
 }
 
-void updateMainMenu(float dt) {
-	// Not enough time and space to do too much here so let's just show the title
-	drawTitle();
+// Acts on the button and moves the current scene on, which is where the game itself is simulated
+void updateScenes(float dt) {
+	readButton();
+	steerPaddles();
+	scenes.update(dt);
+}
+
+// Draws whatever the current scene shows
+void render(float dt) {
+	switch (scenes.currentScene()) {
+		case SCENE_MENU:
+			// Not enough time and space to do too much here so let's just show the title
+			drawTitle();
+			break;
+		case SCENE_COUNTDOWN:
+		case SCENE_RALLY:
+			drawGame(dt);
+			break;
+		case SCENE_SCORE:
+		case SCENE_FINAL_SCORE:
+			// The last frame of the point stays up for a moment, then the score
+			if (scenes.timeInScene() >= POINT_HOLD_TIME) {
+				drawScore();
+			}
+			break;
+		case SCENE_FINAL_ROUND:
+			drawFinalRound();
+			break;
+		case SCENE_WIN:
+			if (scenes.timeInScene() < POINT_HOLD_TIME) {
+				break;
+			}
+			if (game.getStats().leftScore >= WINNING_SCORE) {
+				drawLeftWinScreen();
+			} else {
+				drawRightWinScreen();
+			}
+			break;
+	}
+}
+
+#if PRINT_TASK_STATS
+void printTaskStats(float dt) {
+	for (int i = 0; i < scheduler.numberOfTasks(); ++i) {
+		const TaskStats& stats = scheduler.getStats(i);
+		Serial.printf("task %d: %lu runs, %lu missed, %lu skipped, %lu us avg, %lu us max, %lu us max late\n", i, stats.runs, stats.misses, stats.skipped, stats.runs ? (unsigned long)(stats.totalRuntime / stats.runs) : 0, stats.maxRuntime, stats.maxLateness);
+	}
+	scheduler.resetStats();
+
+	const FrameStats& frames = pacer.getStats();
+	Serial.printf("frames: %lu, %lu dropped, %lu held for the display, %lu-%lu us apart, %.1f us mean, %.1f us rms jitter, %lu us max\n", frames.frames, frames.dropped, frames.aligned, frames.minInterval, frames.maxInterval, pacer.meanInterval(), pacer.jitter(), frames.maxJitter);
+	pacer.resetStats();
+}
+#endif
+
+// Every round starts with the ball held in the middle while the game counts down its start delay
+void enterCountdown() {
+	game.resetPlayersAndBall();
+}
+
+void updateCountdown(float dt) {
+	playGame(dt);
+	if (!game.ballIsPaused()) {
+		scenes.change(SCENE_RALLY);
+	}
 }
 
 // Our game loop
-void updateGame(float dt) {
+void updateRally(float dt) {
 	// Check whether round was won
 	if (game.winCondition()) {
-		delay(500);
-		if (game.getStats().leftScore >= WINNING_SCORE) {
-			drawLeftWinScreen();
-			delay(5000);
-			goToMainMenu();
-		} else if (game.getStats().rightScore >= WINNING_SCORE) {
-			drawRightWinScreen();
-			delay(5000);
-			goToMainMenu();
+		if (game.getStats().leftScore >= WINNING_SCORE || game.getStats().rightScore >= WINNING_SCORE) {
+			scenes.change(SCENE_WIN);
+		} else if (game.getStats().leftScore == WINNING_SCORE - 1 && game.getStats().leftScore == game.getStats().rightScore) {
+			scenes.change(SCENE_FINAL_SCORE);
 		} else {
-			game.changeStartDelay(ROUND_START_DELAY);
-			drawScore();
-			if (game.getStats().leftScore == WINNING_SCORE - 1 && game.getStats().leftScore == game.getStats().rightScore) {
-				delay(2000);
-				drawFinalRound();
-				delay(2000);
-				// Increase initial ball speed and boundary change color speed
-				game.changeBallInitialVelocity(physics::vector2d(BALL_FINAL_ROUND_SPEED, BALL_FINAL_ROUND_SPEED));
-				boundaryChangeColorSpeed = FINAL_ROUND_BOUNDARY_CHANGE_COLOR_SPEED;
-			} else {
-				delay(2000);
-			}
-			game.resetPlayersAndBall();
-		} 
+			scenes.change(SCENE_SCORE);
+		}
 	} else {
-		// Get controller input and convert to player position
-		float playerExtentY = PLAYER_HEIGHT * 0.5f;
-		for (int i = 0; i < NUM_PLAYERS; ++i) {
-			if (game.playerIsActive(i)) {
-				// Convert the analog input to the player's desired position
-				int val = analogRead(playerPin[i]);
-				float desiredPositionY = map(val, 0, 1023, 0, 23);
-				
-				// Now set player's velocity such that he will be in the desired position next tick
-				float currentPositionY = game.getPlayer(i).getPaddle()->getPosition().y;
-				float distance = desiredPositionY - currentPositionY;
-				
-				// Smooth out low distances
-				if (distance >= 0) {
-					if (distance < 1) {
-						distance = 0;
-					} else if (distance < 2) {
-						distance = 1;
-					}
-				} else {
-					if (distance > -1) {
-						distance = 0;
-					} else if (distance > -2) {
-						distance = -1;
-					}
-				}
-				
-				float speed = (float)distance / dt;
-				controller[i].setSpeed(speed);
-			}
+		playGame(dt);
+	}
+}
+
+// Simulate the game up to now and beep for what happened
+void playGame(float dt) {
+	game.advance(dt);
+
+	// Beep for what the balls hit; only one tone plays at a time, so a paddle hit wins over walls
+	bool paddleHit = false;
+	bool wallHit = false;
+	CollisionEvent event;
+	while (game.nextCollisionEvent(event)) {
+		if (event.type == CONTACT_PADDLE) {
+			paddleHit = true;
+		} else {
+			wallHit = true;
 		}
-		
-		// Simulate the game
-		game.tick(dt);
-		
-		// Draw the game
-		drawGame(dt);
 	}
+	if (paddleHit) {
+		playHighBeep();
+	} else if (wallHit) {
+		playLowBeep();
+	}
+}
+
+void enterScore() {
+	game.changeStartDelay(ROUND_START_DELAY);
+}
+
+// Increase initial ball speed and boundary change color speed
+void enterFinalRound() {
+	game.changeBallInitialVelocity(physics::vector2d(BALL_FINAL_ROUND_SPEED, BALL_FINAL_ROUND_SPEED));
+	boundaryChangeColorSpeed = FINAL_ROUND_BOUNDARY_CHANGE_COLOR_SPEED;
 }
 
 void drawGame(float dt) {
@@ -393,7 +580,7 @@ void drawGame(float dt) {
 		// Change to a new color
 		int newBoundaryColor = currentBoundaryColor;
 		while (newBoundaryColor == currentBoundaryColor) {
-			newBoundaryColor = random(5);
+			newBoundaryColor = colorRandom.below(5);
 		}
 		currentBoundaryColor = newBoundaryColor;
 	}
@@ -420,14 +607,24 @@ void drawGame(float dt) {
 		draw.line(x0, y0, x1, y1);
 	}
 
-	// Ball
+	for (int i = 0; i < game.numberOfSegmentWalls(); ++i) {
+		float x0 = game.getUtility().physicsToScreenX(game.XstartOfSegmentWall(i));
+		float y0 = game.getUtility().physicsToScreenY(game.YstartOfSegmentWall(i));
+		float x1 = game.getUtility().physicsToScreenX(game.XendOfSegmentWall(i));
+		float y1 = game.getUtility().physicsToScreenY(game.YendOfSegmentWall(i));
+		draw.line(x0, y0, x1, y1);
+	}
+
+	// Balls
 	draw.setColor(YELLOW);
-	{
-		float x = game.getUtility().physicsToScreenX(game.XpositionOfBall());
-		float y = game.getUtility().physicsToScreenY(game.YpositionOfBall());
-		float w = game.getUtility().physicsToScreen(game.diameterOfBall());
-		float h = w;
-		draw.rect(x+1, y+1, w, h);
+	for (int i = 0; i < game.numberOfBalls(); ++i) {
+		if (game.ballIsActive(i)) {
+			float x = game.getUtility().physicsToScreenX(game.XpositionOfBall(i));
+			float y = game.getUtility().physicsToScreenY(game.YpositionOfBall(i));
+			float w = game.getUtility().physicsToScreen(game.diameterOfBall(i));
+			float h = w;
+			draw.rect(x+1, y+1, w, h);
+		}
 	}
 
 	// Players
@@ -502,7 +699,7 @@ void drawTitle() {
 	draw.setColor(playerColor[0]);
 	draw.string("TENNIS", 4, 17);
 	draw.drawBuffer();
-}
+}
 
 void playLowBeep() {
 	noTone(BUZZER_PIN);
@@ -0,0 +1,27 @@
+// Compiled from libraries/TennisGame/extras/arenas/classic.txt by arena_compiler; edit that and compile it again rather than this
+
+#ifndef CLASSICARENA_ARENA_H
+#define CLASSICARENA_ARENA_H
+
+#include <stdint.h>
+
+const uint8_t classicArena[248] __attribute__((aligned(4))) = {
+	0x54, 0x54, 0x52, 0x41, 0x01, 0x00, 0x60, 0x00, 0xf8, 0x00, 0x00, 0x00, 0xa1, 0xa4, 0x47, 0x05,
+	0x63, 0x6c, 0x61, 0x73, 0x73, 0x69, 0x63, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x02, 0x04, 0x00, 0x04, 0x60, 0x00, 0x00, 0x00, 0x78, 0x00, 0x00, 0x00, 0xa8, 0x00, 0x00, 0x00,
+	0xa8, 0x00, 0x00, 0x00, 0x00, 0x00, 0xd0, 0x41, 0x00, 0x00, 0x30, 0x41, 0x00, 0x00, 0x20, 0x41,
+	0x00, 0x00, 0x20, 0x41, 0x00, 0x00, 0x00, 0x40, 0xcd, 0xcc, 0x8c, 0x3f, 0x00, 0x00, 0x20, 0x40,
+	0x00, 0x00, 0x0c, 0x43, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x3f, 0x00, 0x00, 0x00, 0x40,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5c, 0x42, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0xb8, 0x41, 0x00, 0x00, 0x5c, 0x42, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x40, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xa0, 0x41, 0x00, 0x00, 0x40, 0x40,
+	0x00, 0x00, 0x5c, 0x42, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x40, 0x00, 0x00, 0x5c, 0x42,
+	0x00, 0x00, 0xa0, 0x41, 0x00, 0x00, 0x40, 0x40, 0x00, 0x00, 0x80, 0x40, 0x00, 0x00, 0x10, 0x41,
+	0x00, 0x00, 0x80, 0x3f, 0x00, 0x00, 0xa0, 0x40, 0x00, 0x00, 0xc8, 0x42, 0x00, 0x00, 0x48, 0x42,
+	0x00, 0x00, 0x10, 0x41, 0x00, 0x00, 0x80, 0x3f, 0x00, 0x00, 0xa0, 0x40, 0x00, 0x00, 0xc8, 0x42,
+	0x00, 0x00, 0x0c, 0x42, 0x00, 0x00, 0x10, 0x41, 0x00, 0x00, 0x80, 0x3f, 0x00, 0x00, 0xa0, 0x40,
+	0x00, 0x00, 0xc8, 0x42, 0x00, 0x00, 0x98, 0x41, 0x00, 0x00, 0x10, 0x41, 0x00, 0x00, 0x80, 0x3f,
+	0x00, 0x00, 0xa0, 0x40, 0x00, 0x00, 0xc8, 0x42,
+};
+
+#endif
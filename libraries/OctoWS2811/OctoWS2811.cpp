@@ -212,6 +212,11 @@ int OctoWS2811::busy(void)
 	return 0;
 }
 
+uint32_t OctoWS2811::completedAt(void)
+{
+	return update_completed_at;
+}
+
 void OctoWS2811::show(void)
 {
 	uint32_t cv, sc;
@@ -64,6 +64,8 @@ public:
 
 	void show(void);
 	int busy(void);
+	// micros() when the last update finished sending
+	uint32_t completedAt(void);
 
 	int numPixels(void) {
 		return stripLen * numStrips();
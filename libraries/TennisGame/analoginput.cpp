@@ -0,0 +1,104 @@
+#include "analoginput.h"
+#include <math.h>
+
+void AlphaBetaFilter::setup(float _alpha) {
+	alpha = _alpha;
+	float root = 1 - sqrtf(1 - alpha);
+	beta = root * root;
+	position = 0;
+	velocity = 0;
+	started = false;
+}
+
+void AlphaBetaFilter::update(float measurement, float dt) {
+	if (!started || dt <= 0) {
+		if (!started) {
+			position = measurement;
+			velocity = 0;
+			started = true;
+		}
+		return;
+	}
+	float predicted = position + velocity * dt;
+	float residual = measurement - predicted;
+	position = predicted + alpha * residual;
+	velocity += beta * residual / dt;
+}
+
+float AlphaBetaFilter::predict(float ahead) const {
+	return position + velocity * ahead;
+}
+
+AnalogInput::AnalogInput(AnalogSource* _source, int _numChannels) : samples(0), overruns(0), source(_source), responseTime(1.0f / 60) {
+	numChannels = _numChannels < MAX_ANALOG_CHANNELS ? _numChannels : MAX_ANALOG_CHANNELS;
+	setRange(0, 1);
+	setAlpha(ANALOG_FILTER_ALPHA);
+	for (int i = 0; i < MAX_ANALOG_CHANNELS; ++i) {
+		lastSample[i] = 0;
+	}
+}
+
+void AnalogInput::setRange(float _low, float _high) {
+	low = _low;
+	scale = (_high - _low) / ANALOG_FULL_SCALE;
+}
+
+void AnalogInput::setAlpha(float alpha) {
+	for (int i = 0; i < MAX_ANALOG_CHANNELS; ++i) {
+		filter[i].setup(alpha);
+	}
+}
+
+void AnalogInput::setResponseTime(float _responseTime) {
+	responseTime = _responseTime;
+}
+
+void AnalogInput::sample(unsigned long now) {
+	for (int i = 0; i < numChannels; ++i) {
+		AnalogSample sample = {now, source->read(i)};
+		if (!buffer[i].push(sample)) {
+			++overruns;
+		}
+	}
+	++samples;
+}
+
+void AnalogInput::update() {
+	for (int i = 0; i < numChannels; ++i) {
+		AnalogSample sample;
+		while (buffer[i].pop(sample)) {
+			float dt = (long)(sample.time - lastSample[i]) / 1000000.0f;
+			filter[i].update(low + sample.value * scale, dt);
+			lastSample[i] = sample.time;
+		}
+	}
+}
+
+float AnalogInput::predict(int channel, unsigned long at) const {
+	long ahead = (long)(at - lastSample[channel]);
+	if (ahead < 0) {
+		ahead = 0;
+	} else if (ahead > ANALOG_MAX_LOOKAHEAD) {
+		ahead = ANALOG_MAX_LOOKAHEAD;
+	}
+	float position = filter[channel].predict(ahead / 1000000.0f);
+
+	// Overshooting the end of the knob's travel isn't somewhere the knob can be; a reversed range has its ends swapped
+	float end = low + scale * ANALOG_FULL_SCALE;
+	float lowest = low < end ? low : end;
+	float highest = low < end ? end : low;
+	if (position < lowest) {
+		position = lowest;
+	} else if (position > highest) {
+		position = highest;
+	}
+	return position;
+}
+
+void AnalogInput::steer(int channel, float paddlePosition, unsigned long at, PlayerController& controller) const {
+	float distance = predict(channel, at) - paddlePosition;
+	if (distance < ANALOG_DEAD_ZONE && distance > -ANALOG_DEAD_ZONE) {
+		distance = 0;
+	}
+	controller.setSpeed(distance / responseTime);
+}
\ No newline at end of file
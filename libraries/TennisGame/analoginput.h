@@ -0,0 +1,94 @@
+#ifndef ANALOGINPUT_H
+#define ANALOGINPUT_H
+
+#include <stdint.h>
+#include "controller.h"
+#include "entities.h"
+#include "ringbuffer.h"
+
+// One channel per knob
+#define MAX_ANALOG_CHANNELS MAX_NUM_PLAYERS
+
+// Samples a channel holds between two updates; must be a power of two
+#define ANALOG_SAMPLE_BUFFER 16
+
+// Highest reading a source gives, i.e. analogRead() at 10 bits
+#define ANALOG_FULL_SCALE 1023
+
+// How much of each sample's surprise goes into the position; the velocity gain follows from it
+#define ANALOG_FILTER_ALPHA 0.3f
+
+// Furthest ahead of the last sample a position is extrapolated, in microseconds
+#define ANALOG_MAX_LOOKAHEAD 20000
+
+// Gaps between paddle and knob smaller than this, in units, are left alone so a still knob gives a still paddle
+#define ANALOG_DEAD_ZONE 0.25f
+
+// Where readings come from: analogRead() on the Teensy, a made-up signal on the PC
+class AnalogSource {
+public:
+	virtual int read(int channel) = 0;
+};
+
+struct AnalogSample {
+	unsigned long time;
+	int value;
+};
+
+// Tracks a position and its velocity from noisy measurements taken at uneven times.
+// The velocity gain is the critically damped one for alpha, beta = (1 - sqrt(1 - alpha))^2, so a step settles without overshooting.
+struct AlphaBetaFilter {
+	float position;
+	float velocity;
+	float alpha;
+	float beta;
+	bool started;
+
+	void setup(float _alpha);
+	void update(float measurement, float dt);
+	float predict(float ahead) const;
+};
+
+// Reads knobs at a fixed rate into a ring buffer per channel, and turns them into paddle speeds.
+// sample() is the producer and can run anywhere, even in an interrupt; update(), predict() and steer() are the
+// consumer and belong with the physics. Each sample keeps the time it was taken, so the filter uses the real
+// spacing however unevenly sample() gets called.
+class AnalogInput {
+public:
+	AnalogInput(AnalogSource* _source, int _numChannels);
+
+	// Positions, in units, that a reading of 0 and of ANALOG_FULL_SCALE stand for
+	void setRange(float _low, float _high);
+	void setAlpha(float alpha);
+
+	// Seconds a paddle is given to close the gap to its knob
+	void setResponseTime(float _responseTime);
+
+	// Producer side: reads every channel once, stamped with now in microseconds
+	void sample(unsigned long now);
+
+	// Consumer side: runs the filters over every sample taken since the last update
+	void update();
+
+	// Filtered position of a knob, extrapolated to a time in microseconds
+	float predict(int channel, unsigned long at) const;
+
+	// Sets a controller's speed so a paddle at paddlePosition gets to where its knob is predicted to be at at
+	void steer(int channel, float paddlePosition, unsigned long at, PlayerController& controller) const;
+
+	// Samples read, and samples lost because the consumer fell a whole buffer behind
+	unsigned long samples;
+	unsigned long overruns;
+
+private:
+	AnalogSource* source;
+	int numChannels;
+	float low;
+	float scale;
+	float responseTime;
+	RingBuffer<AnalogSample, ANALOG_SAMPLE_BUFFER> buffer[MAX_ANALOG_CHANNELS];
+	AlphaBetaFilter filter[MAX_ANALOG_CHANNELS];
+	unsigned long lastSample[MAX_ANALOG_CHANNELS];
+};
+
+#endif
\ No newline at end of file
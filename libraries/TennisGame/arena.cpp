@@ -0,0 +1,127 @@
+#include "arena.h"
+
+uint32_t arenaChecksum(uint32_t hash, const void* data, unsigned long size) {
+	const uint8_t* bytes = (const uint8_t*)data;
+	for (unsigned long i = 0; i < size; ++i) {
+		hash = (hash ^ bytes[i]) * 16777619u;
+	}
+	return hash;
+}
+
+static physics::vector2d toVector(const ArenaPoint& point) {
+	return physics::vector2d(point.x, point.y);
+}
+
+Arena::Arena() : data(0) {
+}
+
+ArenaError Arena::load(const void* _data, unsigned long size) {
+	data = 0;
+	const ArenaHeader* header = (const ArenaHeader*)_data;
+	if (size < sizeof(ArenaHeader)) {
+		return ARENA_TOO_SMALL;
+	}
+	if ((uintptr_t)_data % ARENA_ALIGNMENT) {
+		return ARENA_MISALIGNED;
+	}
+	if (header->magic != ARENA_MAGIC) {
+		return ARENA_BAD_MAGIC;
+	}
+	if (header->version != ARENA_VERSION || header->headerSize != sizeof(ArenaHeader)) {
+		return ARENA_BAD_VERSION;
+	}
+	// A size smaller than the header would have the checksum run off the end of the blob
+	if (header->size < sizeof(ArenaHeader) || header->size > size || header->size % ARENA_ALIGNMENT) {
+		return ARENA_BAD_SIZE;
+	}
+	if (arenaChecksum(2166136261u, header + 1, header->size - sizeof(ArenaHeader)) != header->checksum) {
+		return ARENA_BAD_CHECKSUM;
+	}
+
+	data = (const uint8_t*)_data;
+	if (!sectionFits(header->horizontalWallOffset, header->numHorizontalWalls, sizeof(ArenaWall)) ||
+		!sectionFits(header->verticalWallOffset, header->numVerticalWalls, sizeof(ArenaWall)) ||
+		!sectionFits(header->segmentWallOffset, header->numSegmentWalls, sizeof(ArenaSegmentWall)) ||
+		!sectionFits(header->paddleOffset, header->numPaddles, sizeof(ArenaPaddle))) {
+		data = 0;
+		return ARENA_BAD_SECTION;
+	}
+
+	if (header->ball.count < 1) {
+		data = 0;
+		return ARENA_NO_BALLS;
+	}
+
+	// The game's bounds are fixed-size arrays that are all checked every tick, so there can't be fewer walls than it has either
+	if (header->numHorizontalWalls != NUM_HORIZONTAL_WALLS || header->numVerticalWalls != NUM_VERTICAL_WALLS ||
+		header->numSegmentWalls > MAX_SEGMENT_WALLS || header->numPaddles > MAX_NUM_PLAYERS || header->ball.count > MAX_NUM_BALLS) {
+		data = 0;
+		return ARENA_TOO_BIG_FOR_GAME;
+	}
+	return ARENA_OK;
+}
+
+bool Arena::sectionFits(uint32_t offset, unsigned long count, unsigned long itemSize) const {
+	if (count == 0) {
+		return true;
+	}
+	const ArenaHeader& arena = header();
+	return offset % ARENA_ALIGNMENT == 0 && offset >= sizeof(ArenaHeader) && offset <= arena.size && count * itemSize <= arena.size - offset;
+}
+
+bool Arena::loaded() const {
+	return data != 0;
+}
+
+const ArenaHeader& Arena::header() const {
+	return *(const ArenaHeader*)data;
+}
+
+const ArenaWall* Arena::horizontalWalls() const {
+	return (const ArenaWall*)(data + header().horizontalWallOffset);
+}
+
+const ArenaWall* Arena::verticalWalls() const {
+	return (const ArenaWall*)(data + header().verticalWallOffset);
+}
+
+const ArenaSegmentWall* Arena::segmentWalls() const {
+	return (const ArenaSegmentWall*)(data + header().segmentWallOffset);
+}
+
+const ArenaPaddle* Arena::paddles() const {
+	return (const ArenaPaddle*)(data + header().paddleOffset);
+}
+
+void Arena::apply(GameSettings& settings) const {
+	const ArenaHeader& arena = header();
+	for (int i = 0; i < arena.numHorizontalWalls; ++i) {
+		settings.horizontalWallPoints[i] = toVector(horizontalWalls()[i].position);
+		settings.horizontalWallLengths[i] = horizontalWalls()[i].length;
+	}
+	for (int i = 0; i < arena.numVerticalWalls; ++i) {
+		settings.verticalWallPoints[i] = toVector(verticalWalls()[i].position);
+		settings.verticalWallLengths[i] = verticalWalls()[i].length;
+	}
+	settings.numSegmentWalls = arena.numSegmentWalls;
+	for (int i = 0; i < arena.numSegmentWalls; ++i) {
+		settings.segmentWallStarts[i] = toVector(segmentWalls()[i].start);
+		settings.segmentWallEnds[i] = toVector(segmentWalls()[i].end);
+	}
+	for (int i = 0; i < arena.numPaddles; ++i) {
+		settings.playerInitialPoint[i] = toVector(paddles()[i].spawn);
+		settings.playerLength[i] = paddles()[i].length;
+		settings.playerHeight[i] = paddles()[i].height;
+		settings.playerMaxMoveSpeed[i] = paddles()[i].maxMoveSpeed;
+	}
+
+	settings.numBalls = arena.ball.count;
+	settings.ballInitialPoint = toVector(arena.ball.spawn);
+	settings.ballInitialVelocity = toVector(arena.ball.velocity);
+	settings.ballDiameter = arena.ball.diameter;
+	settings.ballVelocityIncrease = arena.ball.velocityIncrease;
+	settings.ballVelocityIncreaseInterval = arena.ball.velocityIncreaseInterval;
+	settings.maxBallVelocity = arena.ball.maxVelocity;
+	settings.speed = arena.speed;
+	settings.startDelay = arena.startDelay;
+}
\ No newline at end of file
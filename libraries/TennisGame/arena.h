@@ -0,0 +1,122 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stdint.h>
+#include "gameconfig.h"
+
+// An arena blob is laid out exactly as the structs below: a header, then its sections at the offsets the header gives.
+// Numbers are little-endian and coordinates are IEEE floats whatever the physics scalar, so one blob works on the Teensy
+// and on the PC, and it's read where it lies, from flash or an mmapped file, without being parsed or copied.
+// Every struct is a multiple of 4 bytes and every section starts on a multiple of 4 from the start of the blob,
+// which has to be 4-byte aligned itself.
+#define ARENA_MAGIC 0x41525454u
+#define ARENA_VERSION 1
+#define ARENA_ALIGNMENT 4
+#define ARENA_NAME_LENGTH 16
+
+struct ArenaPoint {
+	float x;
+	float y;
+};
+
+// Position and length as in GameSettings
+struct ArenaWall {
+	ArenaPoint position;
+	float length;
+};
+
+struct ArenaSegmentWall {
+	ArenaPoint start;
+	ArenaPoint end;
+};
+
+struct ArenaPaddle {
+	ArenaPoint spawn;
+	float length;
+	float height;
+	float maxMoveSpeed;
+};
+
+struct ArenaBall {
+	ArenaPoint spawn;
+	ArenaPoint velocity;
+	float diameter;
+	float velocityIncrease;
+	float velocityIncreaseInterval;
+	float maxVelocity;
+	uint32_t count;
+};
+
+struct ArenaHeader {
+	uint32_t magic;
+	uint16_t version;
+	uint16_t headerSize;
+
+	// Bytes in the whole blob, and the FNV-1a hash of all of them after the header
+	uint32_t size;
+	uint32_t checksum;
+
+	// Zero padded, and not always zero terminated
+	char name[ARENA_NAME_LENGTH];
+
+	uint8_t numHorizontalWalls;
+	uint8_t numVerticalWalls;
+	uint8_t numSegmentWalls;
+	uint8_t numPaddles;
+
+	// From the start of the blob
+	uint32_t horizontalWallOffset;
+	uint32_t verticalWallOffset;
+	uint32_t segmentWallOffset;
+	uint32_t paddleOffset;
+
+	ArenaBall ball;
+	float speed;
+	float startDelay;
+};
+
+enum ArenaError {
+	ARENA_OK,
+	ARENA_TOO_SMALL,
+	ARENA_MISALIGNED,
+	ARENA_BAD_MAGIC,
+	ARENA_BAD_VERSION,
+	ARENA_BAD_SIZE,
+	ARENA_BAD_CHECKSUM,
+	ARENA_BAD_SECTION,
+
+	// A round with no ball in play is over before it starts
+	ARENA_NO_BALLS,
+
+	// Valid, but more than this build's game can hold; the wall counts have to match it exactly
+	ARENA_TOO_BIG_FOR_GAME
+};
+
+// FNV-1a over a run of bytes, continuing from hash
+uint32_t arenaChecksum(uint32_t hash, const void* data, unsigned long size);
+
+// A checked view of an arena blob. Nothing is copied, so the blob has to outlive it.
+class Arena {
+public:
+	Arena();
+
+	// Checks the header, checksum and sections, and points the arena into the blob if they're sound
+	ArenaError load(const void* data, unsigned long size);
+	bool loaded() const;
+
+	const ArenaHeader& header() const;
+	const ArenaWall* horizontalWalls() const;
+	const ArenaWall* verticalWalls() const;
+	const ArenaSegmentWall* segmentWalls() const;
+	const ArenaPaddle* paddles() const;
+
+	// Writes the walls, spawns and tuning over settings; paddles the arena doesn't have keep what settings gave them
+	void apply(GameSettings& settings) const;
+
+private:
+	bool sectionFits(uint32_t offset, unsigned long count, unsigned long itemSize) const;
+
+	const uint8_t* data;
+};
+
+#endif
\ No newline at end of file
@@ -1,57 +1,75 @@
-#include "ball.h"
-
-void Ball::setup(physics::vector2d p, float diameter, physics::vector2d velocity) {
-	box.extents.x = diameter * 0.5f;
-	box.extents.y = box.extents.x;
-	box.position.x = p.x + box.extents.x;
-	box.position.y = p.y + box.extents.y;
-	box.velocity = velocity;
-}
-
-void Ball::setPosition(physics::vector2d position) {
-	box.position = position;
-}
-
-physics::vector2d Ball::getPosition() const {
-	return box.position;
-}
-
-float Ball::getRadius() const {
-	return box.extents.x;
-}
-
-void Ball::reverseVelocityX() {
-	box.velocity.x *= -1.0f;
-}
-
-void Ball::reverseVelocityY() {
-	box.velocity.y *= -1.0f;
-}
-
-void Ball::setVelocityX(float speed) {
-	box.velocity.x = speed;
-}
-
-float Ball::getVelocityX() {
-	return box.velocity.x;
-}
-
-void Ball::setVelocityY(float speed) {
-	box.velocity.y = speed;
-}
-
-float Ball::getVelocityY() {
-	return box.velocity.y;
-}
-
-void Ball::increaseVelocity(float mult) {
-	box.velocity *= mult;
-}
-
-void Ball::updatePhysics(float dt) {
-	box.position += box.velocity * dt;
-}
-
-const physics::MovingBox* Ball::getPhysicsObject() const {
-	return &box;
+#include "ball.h"
+
+void Ball::bind(BallArrays* _bodies, int _index) {
+	bodies = _bodies;
+	index = _index;
+}
+
+void Ball::setup(physics::vector2d p, physics::scalar diameter, physics::vector2d velocity) {
+	bodies->extentX[index] = diameter * 0.5f;
+	bodies->extentY[index] = bodies->extentX[index];
+	bodies->positionX[index] = p.x + bodies->extentX[index];
+	bodies->positionY[index] = p.y + bodies->extentY[index];
+	bodies->velocityX[index] = velocity.x;
+	bodies->velocityY[index] = velocity.y;
+	bodies->active[index] = true;
+}
+
+void Ball::setActive(bool active) {
+	bodies->active[index] = active;
+}
+
+bool Ball::isActive() const {
+	return bodies->active[index];
+}
+
+void Ball::setPosition(physics::vector2d position) {
+	bodies->positionX[index] = position.x;
+	bodies->positionY[index] = position.y;
+}
+
+physics::vector2d Ball::getPosition() const {
+	return physics::vector2d(bodies->positionX[index], bodies->positionY[index]);
+}
+
+physics::scalar Ball::getRadius() const {
+	return bodies->extentX[index];
+}
+
+void Ball::reverseVelocityX() {
+	bodies->velocityX[index] = -bodies->velocityX[index];
+}
+
+void Ball::reverseVelocityY() {
+	bodies->velocityY[index] = -bodies->velocityY[index];
+}
+
+void Ball::setVelocityX(physics::scalar speed) {
+	bodies->velocityX[index] = speed;
+}
+
+physics::scalar Ball::getVelocityX() const {
+	return bodies->velocityX[index];
+}
+
+void Ball::setVelocityY(physics::scalar speed) {
+	bodies->velocityY[index] = speed;
+}
+
+physics::scalar Ball::getVelocityY() const {
+	return bodies->velocityY[index];
+}
+
+void Ball::increaseVelocity(physics::scalar mult) {
+	bodies->velocityX[index] *= mult;
+	bodies->velocityY[index] *= mult;
+}
+
+void Ball::updatePhysics(physics::scalar dt) {
+	bodies->positionX[index] += bodies->velocityX[index] * dt;
+	bodies->positionY[index] += bodies->velocityY[index] * dt;
+}
+
+physics::MovingBox Ball::getPhysicsObject() const {
+	return bodies->getBox(index);
 }
\ No newline at end of file
@@ -1,26 +1,31 @@
-#ifndef BALL_H
-#define BALL_H
-
-#include "physics\objects2d.h"
-
-class Ball {
-public:
-	void setup(physics::vector2d p, float diameter, physics::vector2d velocity);
-	void setPosition(physics::vector2d position);
-	physics::vector2d getPosition() const;
-	float getRadius() const;
-	void reverseVelocityX();
-	void reverseVelocityY();
-	void setVelocityX(float speed);
-	float getVelocityX();
-	void setVelocityY(float speed);
-	float getVelocityY();
-	void increaseVelocity(float mult);
-	void updatePhysics(float dt);
-	const physics::MovingBox* getPhysicsObject() const;
-
-private:
-	physics::MovingBox box;
-};
-
+#ifndef BALL_H
+#define BALL_H
+
+#include "entities.h"
+
+class Ball {
+public:
+	Ball() : bodies(0), index(0) {}
+	void bind(BallArrays* _bodies, int _index);
+	void setup(physics::vector2d p, physics::scalar diameter, physics::vector2d velocity);
+	void setActive(bool active);
+	bool isActive() const;
+	void setPosition(physics::vector2d position);
+	physics::vector2d getPosition() const;
+	physics::scalar getRadius() const;
+	void reverseVelocityX();
+	void reverseVelocityY();
+	void setVelocityX(physics::scalar speed);
+	physics::scalar getVelocityX() const;
+	void setVelocityY(physics::scalar speed);
+	physics::scalar getVelocityY() const;
+	void increaseVelocity(physics::scalar mult);
+	void updatePhysics(physics::scalar dt);
+	physics::MovingBox getPhysicsObject() const;
+
+private:
+	BallArrays* bodies;
+	int index;
+};
+
 #endif
\ No newline at end of file
@@ -0,0 +1,57 @@
+#include "broadphase.h"
+
+namespace physics {
+
+	template <typename T>
+	BasicBounds<T> boxBounds(const BasicBox<T>& box) {
+		BasicBounds<T> bounds;
+		bounds.min = box.position - box.extents;
+		bounds.max = box.position + box.extents;
+		return bounds;
+	}
+
+	template <typename T>
+	BasicBounds<T> sweptBounds(T dt, const BasicMovingBox<T>& box) {
+		BasicBounds<T> bounds = boxBounds(box);
+		basic_vector2d<T> d = box.velocity * dt;
+
+		if (d.x < T(0)) {
+			bounds.min.x += d.x;
+		} else {
+			bounds.max.x += d.x;
+		}
+
+		if (d.y < T(0)) {
+			bounds.min.y += d.y;
+		} else {
+			bounds.max.y += d.y;
+		}
+
+		return bounds;
+	}
+
+	template <typename T>
+	BasicBounds<T> lineBounds(const BasicHorizontalLine<T>& line) {
+		BasicBounds<T> bounds;
+		bounds.min = basic_vector2d<T>(line.position.x - line.extent, line.position.y);
+		bounds.max = basic_vector2d<T>(line.position.x + line.extent, line.position.y);
+		return bounds;
+	}
+
+	template <typename T>
+	BasicBounds<T> lineBounds(const BasicVerticalLine<T>& line) {
+		BasicBounds<T> bounds;
+		bounds.min = basic_vector2d<T>(line.position.x, line.position.y - line.extent);
+		bounds.max = basic_vector2d<T>(line.position.x, line.position.y + line.extent);
+		return bounds;
+	}
+
+	#define PHYSICS_INSTANTIATE_BOUNDS(T) \
+		template BasicBounds<T> boxBounds<T>(const BasicBox<T>&); \
+		template BasicBounds<T> sweptBounds<T>(T, const BasicMovingBox<T>&); \
+		template BasicBounds<T> lineBounds<T>(const BasicHorizontalLine<T>&); \
+		template BasicBounds<T> lineBounds<T>(const BasicVerticalLine<T>&);
+
+	PHYSICS_INSTANTIATE_BOUNDS(float)
+	PHYSICS_INSTANTIATE_BOUNDS(fixed)
+}
\ No newline at end of file
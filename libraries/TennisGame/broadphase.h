@@ -0,0 +1,164 @@
+#ifndef BROADPHASE_H
+#define BROADPHASE_H
+
+#include <stdint.h>
+#include "physics/objects2d.h"
+
+namespace physics {
+
+	template <typename T>
+	BasicBounds<T> boxBounds(const BasicBox<T>& box);
+
+	// Everything the box touches while moving for dt
+	template <typename T>
+	BasicBounds<T> sweptBounds(T dt, const BasicMovingBox<T>& box);
+
+	template <typename T>
+	BasicBounds<T> lineBounds(const BasicHorizontalLine<T>& line);
+
+	template <typename T>
+	BasicBounds<T> lineBounds(const BasicVerticalLine<T>& line);
+
+	template <typename T>
+	inline bool boundsOverlap(const BasicBounds<T>& a, const BasicBounds<T>& b) {
+		return a.min.x <= b.max.x && b.min.x <= a.max.x && a.min.y <= b.max.y && b.min.y <= a.max.y;
+	}
+
+	// True when the bounds overlap by more than depth on both axes
+	template <typename T>
+	inline bool boundsOverlapBy(const BasicBounds<T>& a, const BasicBounds<T>& b, T depth) {
+		return a.min.x + depth < b.max.x && b.min.x + depth < a.max.x && a.min.y + depth < b.max.y && b.min.y + depth < a.max.y;
+	}
+
+	// a is the proxy whose mask selected b
+	struct BroadPhasePair {
+		uint8_t a;
+		uint8_t b;
+	};
+
+	// Sort and sweep along x over a fixed number of proxies
+	// Proxies keep their slot between ticks, so the insertion sort only fixes up the few that moved past each other
+	// A pair is reported when one proxy's mask contains the other's category, so static walls (mask 0) never test each other
+	template <typename T, int Capacity>
+	class BasicSortAndSweep {
+	public:
+		BasicSortAndSweep() : count(0) {}
+
+		void clear() {
+			count = 0;
+		}
+
+		int size() const {
+			return count;
+		}
+
+		// Returns the proxy id, or -1 if full
+		int add(const BasicBounds<T>& _bounds, uint8_t _category, uint8_t _mask) {
+			if (count >= Capacity) {
+				return -1;
+			}
+			bounds[count] = _bounds;
+			category[count] = _category;
+			mask[count] = _mask;
+			order[count] = count;
+			return count++;
+		}
+
+		void update(int proxy, const BasicBounds<T>& _bounds) {
+			bounds[proxy] = _bounds;
+		}
+
+		// A category and mask of 0 takes the proxy out of every pair
+		void setFilter(int proxy, uint8_t _category, uint8_t _mask) {
+			category[proxy] = _category;
+			mask[proxy] = _mask;
+		}
+
+		const BasicBounds<T>& getBounds(int proxy) const {
+			return bounds[proxy];
+		}
+
+		// Returns the number of pairs written
+		// Only proxies with a mask go looking, each through the sorted proxies up to the end of its bounds, so the static walls cost nothing
+		int findPairs(BroadPhasePair* pairs, int maxPairs) {
+			sort();
+
+			int numPairs = 0;
+			for (int i = 0; i < count; ++i) {
+				int a = order[i];
+				if (!mask[a]) {
+					continue;
+				}
+				for (int j = 0; j < count; ++j) {
+					int b = order[j];
+
+					// Sorted by min x, so nothing further along can overlap a
+					if (bounds[b].min.x > bounds[a].max.x) {
+						break;
+					}
+					if (!(mask[a] & category[b]) || b == a) {
+						continue;
+					}
+
+					// When both select each other the one earlier in the order reports the pair
+					if ((mask[b] & category[a]) && j < i) {
+						continue;
+					}
+
+					if (bounds[a].min.x <= bounds[b].max.x && bounds[a].min.y <= bounds[b].max.y && bounds[b].min.y <= bounds[a].max.y) {
+						if (numPairs >= maxPairs) {
+							return numPairs;
+						}
+						pairs[numPairs].a = a;
+						pairs[numPairs].b = b;
+						++numPairs;
+					}
+				}
+			}
+			return numPairs;
+		}
+
+		// Proxies in one of the mask's categories that overlap the bounds
+		// Uses the order from the last findPairs, so proxies in those categories must not have been updated since
+		int query(const BasicBounds<T>& queryBounds, uint8_t queryMask, uint8_t* results, int maxResults) const {
+			int numResults = 0;
+			for (int i = 0; i < count; ++i) {
+				int p = order[i];
+				if (!(queryMask & category[p])) {
+					continue;
+				}
+				if (bounds[p].min.x > queryBounds.max.x) {
+					break;
+				}
+				if (boundsOverlap(bounds[p], queryBounds)) {
+					if (numResults >= maxResults) {
+						break;
+					}
+					results[numResults++] = p;
+				}
+			}
+			return numResults;
+		}
+
+	private:
+		void sort() {
+			for (int i = 1; i < count; ++i) {
+				uint8_t p = order[i];
+				int j = i - 1;
+				while (j >= 0 && bounds[order[j]].min.x > bounds[p].min.x) {
+					order[j + 1] = order[j];
+					--j;
+				}
+				order[j + 1] = p;
+			}
+		}
+
+		BasicBounds<T> bounds[Capacity];
+		uint8_t category[Capacity];
+		uint8_t mask[Capacity];
+		uint8_t order[Capacity];
+		int count;
+	};
+}
+
+#endif
\ No newline at end of file
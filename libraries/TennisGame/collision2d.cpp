@@ -1,232 +1,505 @@
-#include "collision2d.h"
-
-namespace physics {
-
-	inline bool rectsOverlap(const vector2d& r1Position, const vector2d& r2Position, const vector2d& r1Extents, const vector2d& r2Extents) {
-		// Check whether boxes overlap
-		vector2d v1 = r1Position - r2Position;
-		vector2d v2 = r1Extents + r2Extents;
-
-		if (v1.x < 0) {
-			v1.x *= -1.0f;
-		}
-
-		if (v1.y < 0) {
-			v1.y *= -1.0f;
-		}
-
-		if (v1.x <= v2.x && v1.y <= v2.y) {
-			return true;
-		}
-
-		return false;
-	}
-
-	inline bool sweepOverlap(const vector2d& d, const vector2d& aMin, const vector2d& aMax, const vector2d& bMin, const vector2d& bMax, float& normalizedTimeOfCollision) {
-		if (d.x == 0.0f) {
-			if ((aMin.x > bMax.x) || (aMax.x < bMin.x)) {
-				return false;
-			}
-		}
-
-		if (d.y == 0.0f) {
-			if ((aMin.y > bMax.y) || (aMax.y < bMin.y)) {
-				return false;
-			}
-		}
-
-		// Normalized interval for dt
-		float tStart = 0.0f;
-		float tEnd = 1.0f;
-
-		// Check for collision in x-axis
-		if (d.x != 0.0f) {
-			float dInverse = 1.0f / d.x;
-		
-			// Compute times for when they begin and end overlapping
-			float xStart = (aMin.x - bMax.x) * dInverse;
-			float xEnd = (aMax.x - bMin.x) * dInverse;
-		
-			// Check for interval out of order
-			if (xStart > xEnd) {
-				float t = xStart;
-				xStart = xEnd;
-				xEnd = t;
-			}
-		
-			// Update interval
-			if (xStart > tStart) {
-				tStart = xStart;
-			}
-
-			if (xEnd < tEnd) {
-				tEnd = xEnd;
-			}
-
-			// Check if this results in an empty interval
-			if (tStart > tEnd) {
-				return false;
-			}
-		}
-
-		// Check for collision in y-axis
-		if (d.y != 0.0f) {
-			float dInverse = 1.0f / d.y;
-
-			// Compute times for when they begin and end overlapping
-			float yStart = (aMin.y - bMax.y) * dInverse;
-			float yEnd = (aMax.y - bMin.y) * dInverse;
-
-			// Check for interval out of order
-			if (yStart > yEnd) {
-				float t = yStart;
-				yStart = yEnd;
-				yEnd = t;
-			}
-
-			// Update interval
-			if (yStart > tStart) {
-				tStart = yStart;
-			}
-
-			if (yEnd < tEnd) {
-				tEnd = yEnd;
-			}
-
-			// Check if this results in an empty interval
-			if (tStart > tEnd) {
-				return false;
-			}
-		}
-
-		// We have an overlap at time
-		normalizedTimeOfCollision = tStart;
-		return true;
-	}
-
-	bool movingBoxCollidesWithHorizontalLine(float dt, const MovingBox& box, const HorizontalLine& line, vector2d& collisionPositionOfBox, float& normalizedTimeOfCollision) {
-		// Convert line to box
-		MovingBox lineBox;
-		lineBox.position = line.position;
-		lineBox.extents = vector2d(line.extent, 0.0f);
-		lineBox.velocity = VECTOR2D_ZERO;
-
-		vector2d collisionPositionOfLine;
-		return movingBoxesCollide(dt, box, lineBox, collisionPositionOfBox, collisionPositionOfLine, normalizedTimeOfCollision);
-	}
-
-	bool movingBoxCollidesWithVerticalLine(float dt, const MovingBox& box, const VerticalLine& line, vector2d& collisionPositionOfBox, float& normalizedTimeOfCollision) {
-		// Convert line to box
-		MovingBox lineBox;
-		lineBox.position = line.position;
-		lineBox.extents = vector2d(0.0f, line.extent);
-		lineBox.velocity = VECTOR2D_ZERO;
-
-		vector2d collisionPositionOfLine;
-		return movingBoxesCollide(dt, box, lineBox, collisionPositionOfBox, collisionPositionOfLine, normalizedTimeOfCollision);
-	}
-
-	inline bool boxesCollide(const Box& a, const Box& b) {
-		return rectsOverlap(a.position, b.position, a.extents, b.extents);
-	}
-
-	bool movingBoxesCollide(float dt, const MovingBox& a, const MovingBox& b, vector2d& collisionPositionOfA, vector2d& collisionPositionOfB, float& normalizedTimeOfCollision) {
-		// TODO? broad phase collision check
-
-		// Is there a collision between the objects at their current position?
-		if (boxesCollide(a, b)) {
-			collisionPositionOfA = a.position;
-			collisionPositionOfB = b.position;
-			normalizedTimeOfCollision = 0;
-			return true;
-		}
-
-		// Displacement
-		vector2d da = (a.position + a.velocity * dt) - a.position;
-		vector2d db = (b.position + b.velocity * dt) - b.position;
-
-		// Solved in A's frame of reference
-		vector2d d = db - da;
-
-		// Quick check if they're not moving or moving at the same speed in one of the axes
-		if (d.x == 0.0f && d.y == 0.0f) {
-			// Since we already checked if they're currently colliding
-			return false;
-		}
-
-		// Vertices
-		vector2d aMin = a.position - a.extents;
-		vector2d aMax = a.position + a.extents;
-		vector2d bMin = b.position - b.extents;
-		vector2d bMax = b.position + b.extents;
-
-		if (sweepOverlap(d, aMin, aMax, bMin, bMax, normalizedTimeOfCollision)) {
-			// We have a collision!
-			collisionPositionOfA = a.position + (da * normalizedTimeOfCollision);
-			collisionPositionOfB = b.position + (db * normalizedTimeOfCollision);
-			return true;
-		}
-
-		// No collision
-		return false;
-	}
-
-	const float padding = 0.01f;
-	vector2d paddedCollisionPosition(const vector2d& positionOfA, const vector2d& extentsOfA, const vector2d& positionOfB, const vector2d& extentsOfB) {
-
-		vector2d position = positionOfA;
-
-		float dx;
-		float dy;
-
-		float px = 0;
-		float py = 0;
-
-		float dx1 = positionOfA.x + extentsOfA.x - positionOfB.x + extentsOfB.x;
-		if (dx1 < 0) {
-			dx1 = -dx1;
-		}
-
-		float dx2 = positionOfB.x + extentsOfB.x - positionOfA.x + extentsOfA.x;
-		if (dx2 < 0) {
-			dx2 = -dx2;
-		}
-
-		if (dx1 <= dx2) {
-			dx = dx1;
-			px = positionOfB.x - extentsOfB.x - extentsOfA.x - padding;
-		} else {
-			dx = dx2;
-			px = positionOfB.x + extentsOfB.x + extentsOfA.x + padding;
-		}
-
-		float dy1 = positionOfA.y + extentsOfA.y - positionOfB.y + extentsOfB.y;
-		if (dy1 < 0) {
-			dy1 = -dy1;
-		}
-
-		float dy2 = positionOfB.y + extentsOfB.y - positionOfA.y + extentsOfA.y;
-		if (dy2 < 0) {
-			dy2 = -dy2;
-		}
-
-		if (dy1 <= dy2) {
-			dy = dy1;
-			py = positionOfB.y - extentsOfB.y - extentsOfA.y - padding;
-		} else {
-			dy = dy2;
-			py = positionOfB.y + extentsOfB.y + extentsOfA.y + padding;
-		}
-
-		if (dx < dy) {
-			position.x = px;
-		} else if (dy < dx) {
-			position.y = py;
-		} else {
-			position.x = px;
-			position.y = py;
-		}
-
-		return position;
-	}
+#include "collision2d.h"
+#include <math.h>
+
+namespace physics {
+
+	template <typename T>
+	inline bool rectsOverlap(const basic_vector2d<T>& r1Position, const basic_vector2d<T>& r2Position, const basic_vector2d<T>& r1Extents, const basic_vector2d<T>& r2Extents) {
+		// Check whether boxes overlap
+		basic_vector2d<T> v1 = r1Position - r2Position;
+		basic_vector2d<T> v2 = r1Extents + r2Extents;
+
+		if (v1.x < T(0)) {
+			v1.x = -v1.x;
+		}
+
+		if (v1.y < T(0)) {
+			v1.y = -v1.y;
+		}
+
+		if (v1.x <= v2.x && v1.y <= v2.y) {
+			return true;
+		}
+
+		return false;
+	}
+
+	template <typename T>
+	inline bool sweepOverlap(const basic_vector2d<T>& d, const basic_vector2d<T>& aMin, const basic_vector2d<T>& aMax, const basic_vector2d<T>& bMin, const basic_vector2d<T>& bMax, T& normalizedTimeOfCollision) {
+		if (d.x == T(0)) {
+			if ((aMin.x > bMax.x) || (aMax.x < bMin.x)) {
+				return false;
+			}
+		}
+
+		if (d.y == T(0)) {
+			if ((aMin.y > bMax.y) || (aMax.y < bMin.y)) {
+				return false;
+			}
+		}
+
+		// Normalized interval for dt
+		T tStart = T(0);
+		T tEnd = T(1);
+
+		// Check for collision in x-axis
+		if (d.x != T(0)) {
+			T dInverse = reciprocal(d.x);
+		
+			// Compute times for when they begin and end overlapping
+			T xStart = (aMin.x - bMax.x) * dInverse;
+			T xEnd = (aMax.x - bMin.x) * dInverse;
+		
+			// Check for interval out of order
+			if (xStart > xEnd) {
+				T t = xStart;
+				xStart = xEnd;
+				xEnd = t;
+			}
+		
+			// Update interval
+			if (xStart > tStart) {
+				tStart = xStart;
+			}
+
+			if (xEnd < tEnd) {
+				tEnd = xEnd;
+			}
+
+			// Check if this results in an empty interval
+			if (tStart > tEnd) {
+				return false;
+			}
+		}
+
+		// Check for collision in y-axis
+		if (d.y != T(0)) {
+			T dInverse = reciprocal(d.y);
+
+			// Compute times for when they begin and end overlapping
+			T yStart = (aMin.y - bMax.y) * dInverse;
+			T yEnd = (aMax.y - bMin.y) * dInverse;
+
+			// Check for interval out of order
+			if (yStart > yEnd) {
+				T t = yStart;
+				yStart = yEnd;
+				yEnd = t;
+			}
+
+			// Update interval
+			if (yStart > tStart) {
+				tStart = yStart;
+			}
+
+			if (yEnd < tEnd) {
+				tEnd = yEnd;
+			}
+
+			// Check if this results in an empty interval
+			if (tStart > tEnd) {
+				return false;
+			}
+		}
+
+		// We have an overlap at time
+		normalizedTimeOfCollision = tStart;
+		return true;
+	}
+
+	template <typename T>
+	bool movingBoxCollidesWithHorizontalLine(T dt, const BasicMovingBox<T>& box, const BasicHorizontalLine<T>& line, basic_vector2d<T>& collisionPositionOfBox, T& normalizedTimeOfCollision) {
+		// Convert line to box
+		BasicMovingBox<T> lineBox;
+		lineBox.position = line.position;
+		lineBox.extents = basic_vector2d<T>(line.extent, T(0));
+		lineBox.velocity = basic_vector2d<T>();
+
+		basic_vector2d<T> collisionPositionOfLine;
+		return movingBoxesCollide(dt, box, lineBox, collisionPositionOfBox, collisionPositionOfLine, normalizedTimeOfCollision);
+	}
+
+	template <typename T>
+	bool movingBoxCollidesWithVerticalLine(T dt, const BasicMovingBox<T>& box, const BasicVerticalLine<T>& line, basic_vector2d<T>& collisionPositionOfBox, T& normalizedTimeOfCollision) {
+		// Convert line to box
+		BasicMovingBox<T> lineBox;
+		lineBox.position = line.position;
+		lineBox.extents = basic_vector2d<T>(T(0), line.extent);
+		lineBox.velocity = basic_vector2d<T>();
+
+		basic_vector2d<T> collisionPositionOfLine;
+		return movingBoxesCollide(dt, box, lineBox, collisionPositionOfBox, collisionPositionOfLine, normalizedTimeOfCollision);
+	}
+
+	template <typename T>
+	inline bool boxesCollide(const BasicBox<T>& a, const BasicBox<T>& b) {
+		return rectsOverlap(a.position, b.position, a.extents, b.extents);
+	}
+
+	template <typename T>
+	bool movingBoxesCollide(T dt, const BasicMovingBox<T>& a, const BasicMovingBox<T>& b, basic_vector2d<T>& collisionPositionOfA, basic_vector2d<T>& collisionPositionOfB, T& normalizedTimeOfCollision) {
+		// Callers cull pairs with the broad phase in broadphase.h before getting here
+
+		// Is there a collision between the objects at their current position?
+		if (boxesCollide(a, b)) {
+			collisionPositionOfA = a.position;
+			collisionPositionOfB = b.position;
+			normalizedTimeOfCollision = T(0);
+			return true;
+		}
+
+		// Displacement
+		basic_vector2d<T> da = (a.position + a.velocity * dt) - a.position;
+		basic_vector2d<T> db = (b.position + b.velocity * dt) - b.position;
+
+		// Solved in A's frame of reference
+		basic_vector2d<T> d = db - da;
+
+		// Quick check if they're not moving or moving at the same speed in one of the axes
+		if (d.x == T(0) && d.y == T(0)) {
+			// Since we already checked if they're currently colliding
+			return false;
+		}
+
+		// Vertices
+		basic_vector2d<T> aMin = a.position - a.extents;
+		basic_vector2d<T> aMax = a.position + a.extents;
+		basic_vector2d<T> bMin = b.position - b.extents;
+		basic_vector2d<T> bMax = b.position + b.extents;
+
+		if (sweepOverlap(d, aMin, aMax, bMin, bMax, normalizedTimeOfCollision)) {
+			// We have a collision!
+			collisionPositionOfA = a.position + (da * normalizedTimeOfCollision);
+			collisionPositionOfB = b.position + (db * normalizedTimeOfCollision);
+			return true;
+		}
+
+		// No collision
+		return false;
+	}
+
+	template <typename T>
+	inline T component(const basic_vector2d<T>& v, int axis) {
+		return axis == 0 ? v.x : v.y;
+	}
+
+	template <typename T>
+	inline bool touchesBounds(const basic_vector2d<T>& aMin, const basic_vector2d<T>& aMax, const BasicBounds<T>& bounds) {
+		return aMin.x <= bounds.max.x && aMax.x >= bounds.min.x && aMin.y <= bounds.max.y && aMax.y >= bounds.min.y;
+	}
+
+	template <int Shape>
+	struct StaticSweep;
+
+	template <>
+	struct StaticSweep<STATIC_BOX> {
+		template <typename T>
+		static bool test(T dt, const BasicMovingBox<T>& box, const BasicBounds<T>& bounds, basic_vector2d<T>& collisionPositionOfBox, T& normalizedTimeOfCollision) {
+			basic_vector2d<T> aMin = box.position - box.extents;
+			basic_vector2d<T> aMax = box.position + box.extents;
+
+			if (touchesBounds(aMin, aMax, bounds)) {
+				collisionPositionOfBox = box.position;
+				normalizedTimeOfCollision = T(0);
+				return true;
+			}
+
+			// The collider doesn't move, so in the box's frame of reference it just goes the other way
+			basic_vector2d<T> da = box.velocity * dt;
+			basic_vector2d<T> d = basic_vector2d<T>(-da.x, -da.y);
+			if (d.x == T(0) && d.y == T(0)) {
+				return false;
+			}
+
+			if (sweepOverlap(d, aMin, aMax, bounds.min, bounds.max, normalizedTimeOfCollision)) {
+				collisionPositionOfBox = box.position + (da * normalizedTimeOfCollision);
+				return true;
+			}
+			return false;
+		}
+	};
+
+	// Along is the axis the line runs along
+	template <int Along>
+	struct LineSweep {
+		template <typename T>
+		static bool test(T dt, const BasicMovingBox<T>& box, const BasicBounds<T>& bounds, basic_vector2d<T>& collisionPositionOfBox, T& normalizedTimeOfCollision) {
+			const int Across = 1 - Along;
+
+			basic_vector2d<T> aMin = box.position - box.extents;
+			basic_vector2d<T> aMax = box.position + box.extents;
+
+			if (touchesBounds(aMin, aMax, bounds)) {
+				collisionPositionOfBox = box.position;
+				normalizedTimeOfCollision = T(0);
+				return true;
+			}
+
+			basic_vector2d<T> da = box.velocity * dt;
+
+			// Interval in which the box straddles the line's axis
+			T line = component(bounds.min, Across);
+			T dAcross = component(da, Across);
+			T tStart = T(0);
+			T tEnd = T(1);
+			if (dAcross == T(0)) {
+				if (line < component(aMin, Across) || line > component(aMax, Across)) {
+					return false;
+				}
+			} else {
+				T dInverse = reciprocal(dAcross);
+				T acrossStart = (line - component(aMax, Across)) * dInverse;
+				T acrossEnd = (line - component(aMin, Across)) * dInverse;
+				if (acrossStart > acrossEnd) {
+					T t = acrossStart;
+					acrossStart = acrossEnd;
+					acrossEnd = t;
+				}
+				if (acrossStart > tStart) {
+					tStart = acrossStart;
+				}
+				if (acrossEnd < tEnd) {
+					tEnd = acrossEnd;
+				}
+				if (tStart > tEnd) {
+					return false;
+				}
+			}
+
+			// Usually the box is already over the line's span as it reaches it
+			T dAlong = component(da, Along);
+			T spanMin = component(bounds.min, Along);
+			T spanMax = component(bounds.max, Along);
+			T lowStart = component(aMin, Along) + dAlong * tStart;
+			T highStart = component(aMax, Along) + dAlong * tStart;
+			if (lowStart > spanMax || highStart < spanMin) {
+				if (dAlong == T(0)) {
+					return false;
+				}
+
+				// Beside the same end of the span for the whole interval
+				T lowEnd = component(aMin, Along) + dAlong * tEnd;
+				T highEnd = component(aMax, Along) + dAlong * tEnd;
+				if ((lowStart > spanMax && lowEnd > spanMax) || (highStart < spanMin && highEnd < spanMin)) {
+					return false;
+				}
+
+				// Comes in off an end part way through
+				T dInverse = reciprocal(dAlong);
+				T alongStart = (spanMin - component(aMax, Along)) * dInverse;
+				T alongEnd = (spanMax - component(aMin, Along)) * dInverse;
+				if (alongStart > alongEnd) {
+					T t = alongStart;
+					alongStart = alongEnd;
+					alongEnd = t;
+				}
+				if (alongStart > tStart) {
+					tStart = alongStart;
+				}
+				if (alongEnd < tEnd) {
+					tEnd = alongEnd;
+				}
+				if (tStart > tEnd) {
+					return false;
+				}
+			}
+
+			normalizedTimeOfCollision = tStart;
+			collisionPositionOfBox = box.position + (da * tStart);
+			return true;
+		}
+	};
+
+	template <>
+	struct StaticSweep<STATIC_HORIZONTAL_LINE> : LineSweep<0> {};
+
+	template <>
+	struct StaticSweep<STATIC_VERTICAL_LINE> : LineSweep<1> {};
+
+	template <int Shape, typename T>
+	bool movingBoxCollidesWithStatic(T dt, const BasicMovingBox<T>& box, const BasicBounds<T>& bounds, basic_vector2d<T>& collisionPositionOfBox, T& normalizedTimeOfCollision) {
+		return StaticSweep<Shape>::test(dt, box, bounds, collisionPositionOfBox, normalizedTimeOfCollision);
+	}
+
+	template <typename T>
+	BasicSegment<T> makeSegment(const basic_vector2d<T>& start, const basic_vector2d<T>& end) {
+		BasicSegment<T> segment;
+		segment.start = start;
+		segment.end = end;
+
+		// Worked out in float whatever the scalar, since this only runs at setup
+		float alongX = toFloat(end.x - start.x);
+		float alongY = toFloat(end.y - start.y);
+		float length = sqrtf(alongX * alongX + alongY * alongY);
+		if (length > 0.0f) {
+			segment.normal = basic_vector2d<T>(T(-alongY / length), T(alongX / length));
+		}
+
+		segment.bounds.min = basic_vector2d<T>(start.x < end.x ? start.x : end.x, start.y < end.y ? start.y : end.y);
+		segment.bounds.max = basic_vector2d<T>(start.x < end.x ? end.x : start.x, start.y < end.y ? end.y : start.y);
+		return segment;
+	}
+
+	// Narrows [tStart, tEnd] to when [low, high], moving by d, overlaps [targetLow, targetHigh]
+	// Sets latest when this axis is the last to start overlapping, and returns false once nothing is left
+	template <typename T>
+	inline bool narrowSweepInterval(T low, T high, T d, T targetLow, T targetHigh, T& tStart, T& tEnd, bool& latest) {
+		latest = false;
+		if (d == T(0)) {
+			return low <= targetHigh && targetLow <= high;
+		}
+
+		T dInverse = reciprocal(d);
+		T enter = (targetLow - high) * dInverse;
+		T exit = (targetHigh - low) * dInverse;
+		if (enter > exit) {
+			T t = enter;
+			enter = exit;
+			exit = t;
+		}
+		if (enter > tStart) {
+			tStart = enter;
+			latest = true;
+		}
+		if (exit < tEnd) {
+			tEnd = exit;
+		}
+		return tStart <= tEnd;
+	}
+
+	template <typename T>
+	bool movingBoxCollidesWithSegment(T dt, const BasicMovingBox<T>& box, const BasicSegment<T>& segment, basic_vector2d<T>& collisionPositionOfBox, T& normalizedTimeOfCollision, basic_vector2d<T>& contactNormal) {
+		basic_vector2d<T> da = box.velocity * dt;
+		basic_vector2d<T> aMin = box.position - box.extents;
+		basic_vector2d<T> aMax = box.position + box.extents;
+		T tStart = T(0);
+		T tEnd = T(1);
+		bool latest;
+
+		// Across the segment the box reaches as far as its corner furthest along the normal
+		const basic_vector2d<T>& n = segment.normal;
+		basic_vector2d<T> offset = box.position - segment.start;
+		T across = offset.x * n.x + offset.y * n.y;
+		T radius = (n.x < T(0) ? -n.x : n.x) * box.extents.x + (n.y < T(0) ? -n.y : n.y) * box.extents.y;
+
+		// Whichever axis starts overlapping last is the one the box is stopped on; past an end that's x or y, where it meets the segment's corner
+		int axis = -1;
+		if (!narrowSweepInterval(across - radius, across + radius, da.x * n.x + da.y * n.y, T(0), T(0), tStart, tEnd, latest)) {
+			return false;
+		}
+		axis = latest ? 0 : axis;
+		if (!narrowSweepInterval(aMin.x, aMax.x, da.x, segment.bounds.min.x, segment.bounds.max.x, tStart, tEnd, latest)) {
+			return false;
+		}
+		axis = latest ? 1 : axis;
+		if (!narrowSweepInterval(aMin.y, aMax.y, da.y, segment.bounds.min.y, segment.bounds.max.y, tStart, tEnd, latest)) {
+			return false;
+		}
+		axis = latest ? 2 : axis;
+
+		// Sides are picked by which way the box overlaps least, which also holds for a box already overlapping at the start
+		T acrossDepth = radius - (across < T(0) ? -across : across);
+		T lowX = aMax.x - segment.bounds.min.x;
+		T highX = segment.bounds.max.x - aMin.x;
+		T lowY = aMax.y - segment.bounds.min.y;
+		T highY = segment.bounds.max.y - aMin.y;
+		if (axis < 0) {
+			T depthX = lowX < highX ? lowX : highX;
+			T depthY = lowY < highY ? lowY : highY;
+			axis = depthX < acrossDepth ? 1 : 0;
+			if (depthY < (axis ? depthX : acrossDepth)) {
+				axis = 2;
+			}
+		}
+
+		switch (axis) {
+			case 1:
+				contactNormal = basic_vector2d<T>(lowX < highX ? -1 : 1, 0);
+				break;
+			case 2:
+				contactNormal = basic_vector2d<T>(0, lowY < highY ? -1 : 1);
+				break;
+			default:
+				contactNormal = across < T(0) ? basic_vector2d<T>(-n.x, -n.y) : n;
+		}
+
+		normalizedTimeOfCollision = tStart;
+		collisionPositionOfBox = box.position + (da * tStart);
+		return true;
+	}
+
+	const float padding = 0.01f;
+	template <typename T>
+	basic_vector2d<T> paddedCollisionPosition(const basic_vector2d<T>& positionOfA, const basic_vector2d<T>& extentsOfA, const basic_vector2d<T>& positionOfB, const basic_vector2d<T>& extentsOfB) {
+
+		basic_vector2d<T> position = positionOfA;
+
+		T dx;
+		T dy;
+
+		T px = T(0);
+		T py = T(0);
+
+		T dx1 = positionOfA.x + extentsOfA.x - positionOfB.x + extentsOfB.x;
+		if (dx1 < T(0)) {
+			dx1 = -dx1;
+		}
+
+		T dx2 = positionOfB.x + extentsOfB.x - positionOfA.x + extentsOfA.x;
+		if (dx2 < T(0)) {
+			dx2 = -dx2;
+		}
+
+		if (dx1 <= dx2) {
+			dx = dx1;
+			px = positionOfB.x - extentsOfB.x - extentsOfA.x - T(padding);
+		} else {
+			dx = dx2;
+			px = positionOfB.x + extentsOfB.x + extentsOfA.x + T(padding);
+		}
+
+		T dy1 = positionOfA.y + extentsOfA.y - positionOfB.y + extentsOfB.y;
+		if (dy1 < T(0)) {
+			dy1 = -dy1;
+		}
+
+		T dy2 = positionOfB.y + extentsOfB.y - positionOfA.y + extentsOfA.y;
+		if (dy2 < T(0)) {
+			dy2 = -dy2;
+		}
+
+		if (dy1 <= dy2) {
+			dy = dy1;
+			py = positionOfB.y - extentsOfB.y - extentsOfA.y - T(padding);
+		} else {
+			dy = dy2;
+			py = positionOfB.y + extentsOfB.y + extentsOfA.y + T(padding);
+		}
+
+		if (dx < dy) {
+			position.x = px;
+		} else if (dy < dx) {
+			position.y = py;
+		} else {
+			position.x = px;
+			position.y = py;
+		}
+
+		return position;
+	}
+
+	// Float for the host and FPU builds, Q16.16 for the Teensy; both are always available so they can be compared
+	#define PHYSICS_INSTANTIATE_COLLISIONS(T) \
+		template bool movingBoxCollidesWithHorizontalLine<T>(T, const BasicMovingBox<T>&, const BasicHorizontalLine<T>&, basic_vector2d<T>&, T&); \
+		template bool movingBoxCollidesWithVerticalLine<T>(T, const BasicMovingBox<T>&, const BasicVerticalLine<T>&, basic_vector2d<T>&, T&); \
+		template bool movingBoxesCollide<T>(T, const BasicMovingBox<T>&, const BasicMovingBox<T>&, basic_vector2d<T>&, basic_vector2d<T>&, T&); \
+		template bool movingBoxCollidesWithStatic<STATIC_BOX, T>(T, const BasicMovingBox<T>&, const BasicBounds<T>&, basic_vector2d<T>&, T&); \
+		template bool movingBoxCollidesWithStatic<STATIC_HORIZONTAL_LINE, T>(T, const BasicMovingBox<T>&, const BasicBounds<T>&, basic_vector2d<T>&, T&); \
+		template bool movingBoxCollidesWithStatic<STATIC_VERTICAL_LINE, T>(T, const BasicMovingBox<T>&, const BasicBounds<T>&, basic_vector2d<T>&, T&); \
+		template BasicSegment<T> makeSegment<T>(const basic_vector2d<T>&, const basic_vector2d<T>&); \
+		template bool movingBoxCollidesWithSegment<T>(T, const BasicMovingBox<T>&, const BasicSegment<T>&, basic_vector2d<T>&, T&, basic_vector2d<T>&); \
+		template basic_vector2d<T> paddedCollisionPosition<T>(const basic_vector2d<T>&, const basic_vector2d<T>&, const basic_vector2d<T>&, const basic_vector2d<T>&);
+
+	PHYSICS_INSTANTIATE_COLLISIONS(float)
+	PHYSICS_INSTANTIATE_COLLISIONS(fixed)
 }
\ No newline at end of file
@@ -1,23 +1,70 @@
-#ifndef COLLISION2D_H
-#define COLLISION2D_H
-
-#include "physics/objects2d.h"
-
-namespace physics {
-
-	inline bool rectsOverlap(const vector2d& r1Position, const vector2d& r2Position, const vector2d& r1Extents, const vector2d& r2Extents);
-
-	inline bool sweepOverlap(const vector2d& d, const vector2d& aMin, const vector2d& aMax, const vector2d& bMin, const vector2d& bMax, float& normalizedTimeOfCollision);
-
-	bool movingBoxCollidesWithHorizontalLine(float dt, const MovingBox& box, const HorizontalLine& line, vector2d& collisionPositionOfBox, float& normalizedTimeOfCollision);
-
-	bool movingBoxCollidesWithVerticalLine(float dt, const MovingBox& box, const VerticalLine& line, vector2d& collisionPositionOfBox, float& normalizedTimeOfCollision);
-
-	inline bool boxesCollide(const Box& a, const Box& b);
-
-	bool movingBoxesCollide(float dt, const MovingBox& a, const MovingBox& b, vector2d& collisionPositionOfA, vector2d& collisionPositionOfB, float& normalizedTimeOfCollision);
-
-	vector2d paddedCollisionPosition(const vector2d& positionOfA, const vector2d& extentsOfA, const vector2d& positionOfB, const vector2d& extentsOfB);
-}
-
+#ifndef COLLISION2D_H
+#define COLLISION2D_H
+
+#include "physics/objects2d.h"
+
+// All tests are templated on the physics scalar and instantiated for both float and physics::fixed in collision2d.cpp
+namespace physics {
+
+	template <typename T>
+	inline bool rectsOverlap(const basic_vector2d<T>& r1Position, const basic_vector2d<T>& r2Position, const basic_vector2d<T>& r1Extents, const basic_vector2d<T>& r2Extents);
+
+	template <typename T>
+	inline bool sweepOverlap(const basic_vector2d<T>& d, const basic_vector2d<T>& aMin, const basic_vector2d<T>& aMax, const basic_vector2d<T>& bMin, const basic_vector2d<T>& bMax, T& normalizedTimeOfCollision);
+
+	template <typename T>
+	bool movingBoxCollidesWithHorizontalLine(T dt, const BasicMovingBox<T>& box, const BasicHorizontalLine<T>& line, basic_vector2d<T>& collisionPositionOfBox, T& normalizedTimeOfCollision);
+
+	template <typename T>
+	bool movingBoxCollidesWithVerticalLine(T dt, const BasicMovingBox<T>& box, const BasicVerticalLine<T>& line, basic_vector2d<T>& collisionPositionOfBox, T& normalizedTimeOfCollision);
+
+	template <typename T>
+	inline bool boxesCollide(const BasicBox<T>& a, const BasicBox<T>& b);
+
+	template <typename T>
+	bool movingBoxesCollide(T dt, const BasicMovingBox<T>& a, const BasicMovingBox<T>& b, basic_vector2d<T>& collisionPositionOfA, basic_vector2d<T>& collisionPositionOfB, T& normalizedTimeOfCollision);
+
+	// Shapes a static collider's bounds can describe; lines have a zero extent across themselves
+	enum StaticShape {
+		STATIC_BOX,
+		STATIC_HORIZONTAL_LINE,
+		STATIC_VERTICAL_LINE
+	};
+
+	// Same result as movingBoxesCollide against a still box, specialized on the collider's shape
+	// The bounds are baked once, so nothing about the static side is recomputed per test
+	// Lines first solve the crossing on their normal axis and only divide along themselves when the box comes in off an end
+	template <int Shape, typename T>
+	bool movingBoxCollidesWithStatic(T dt, const BasicMovingBox<T>& box, const BasicBounds<T>& bounds, basic_vector2d<T>& collisionPositionOfBox, T& normalizedTimeOfCollision);
+
+	// Normal points to the left going from start to end; a zero length segment gets a zero normal and behaves as a point
+	// Uses one square root, so build segments at setup rather than per tick
+	template <typename T>
+	BasicSegment<T> makeSegment(const basic_vector2d<T>& start, const basic_vector2d<T>& end);
+
+	// Separating axis test over time on x, y and the segment's normal, so it costs about the same as the line kernels
+	// contactNormal is the unit axis the box was stopped on, pointing from the segment towards the box: the segment's normal, or x or y where the box meets an end
+	template <typename T>
+	bool movingBoxCollidesWithSegment(T dt, const BasicMovingBox<T>& box, const BasicSegment<T>& segment, basic_vector2d<T>& collisionPositionOfBox, T& normalizedTimeOfCollision, basic_vector2d<T>& contactNormal);
+
+	// Mirrors v in the surface with the given unit normal, with two multiplies per axis and no square root
+	template <typename T>
+	inline basic_vector2d<T> reflect(const basic_vector2d<T>& v, const basic_vector2d<T>& normal) {
+		T along = v.x * normal.x + v.y * normal.y;
+		return v - normal * (along + along);
+	}
+
+	// For two boxes touching with centres offset by d and combined extents e, true when they meet top to bottom rather than side to side
+	// Whichever axis overlaps least is the one they met on; unlike comparing |d| against e, this survives rounding in the contact position
+	template <typename T>
+	inline bool boxesMeetAlongY(const basic_vector2d<T>& d, const basic_vector2d<T>& e) {
+		T overlapX = e.x - (d.x < T(0) ? -d.x : d.x);
+		T overlapY = e.y - (d.y < T(0) ? -d.y : d.y);
+		return overlapY <= overlapX;
+	}
+
+	template <typename T>
+	basic_vector2d<T> paddedCollisionPosition(const basic_vector2d<T>& positionOfA, const basic_vector2d<T>& extentsOfA, const basic_vector2d<T>& positionOfB, const basic_vector2d<T>& extentsOfB);
+}
+
 #endif
\ No newline at end of file
@@ -1,9 +1,9 @@
-#include "controller.h"
-
-void PlayerController::setSpeed(float _speed) {
-	speed = _speed;
-}
-
-float PlayerController::getSpeed() {
-	return speed;
+#include "controller.h"
+
+void PlayerController::setSpeed(float _speed) {
+	speed = _speed;
+}
+
+float PlayerController::getSpeed() {
+	return speed;
 }
\ No newline at end of file
@@ -0,0 +1,88 @@
+#ifndef ENTITIES_H
+#define ENTITIES_H
+
+#include "physics/objects2d.h"
+
+#define MAX_NUM_BALLS 16
+#define MAX_NUM_PLAYERS 4
+
+// Moving boxes stored as a structure of arrays so the per-tick loops walk contiguous data
+// Ball and Paddle are handles to one slot
+template <int Capacity>
+struct BodyArrays {
+	physics::scalar positionX[Capacity];
+	physics::scalar positionY[Capacity];
+	physics::scalar extentX[Capacity];
+	physics::scalar extentY[Capacity];
+	physics::scalar velocityX[Capacity];
+	physics::scalar velocityY[Capacity];
+	bool active[Capacity];
+
+	// Zeroes every slot, used or not, so copies and hashes of the arrays never pick up leftover memory
+	void clear() {
+		for (int i = 0; i < Capacity; ++i) {
+			positionX[i] = 0;
+			positionY[i] = 0;
+			extentX[i] = 0;
+			extentY[i] = 0;
+			velocityX[i] = 0;
+			velocityY[i] = 0;
+			active[i] = false;
+		}
+	}
+
+	// Gathers one slot for the collision functions
+	physics::MovingBox getBox(int i) const {
+		physics::MovingBox box;
+		box.position = physics::vector2d(positionX[i], positionY[i]);
+		box.extents = physics::vector2d(extentX[i], extentY[i]);
+		box.velocity = physics::vector2d(velocityX[i], velocityY[i]);
+		return box;
+	}
+
+	physics::vector2d getExtents(int i) const {
+		return physics::vector2d(extentX[i], extentY[i]);
+	}
+
+	physics::vector2d getVelocity(int i) const {
+		return physics::vector2d(velocityX[i], velocityY[i]);
+	}
+
+	// Bounds of every slot over its move in dt, the same as physics::sweptBounds on each box
+	void sweptBounds(physics::scalar dt, physics::Bounds* bounds, int count) const {
+		for (int i = 0; i < count; ++i) {
+			physics::scalar moveX = velocityX[i] * dt;
+			physics::scalar moveY = velocityY[i] * dt;
+			bounds[i].min = physics::vector2d(positionX[i] - extentX[i], positionY[i] - extentY[i]);
+			bounds[i].max = physics::vector2d(positionX[i] + extentX[i], positionY[i] + extentY[i]);
+			if (moveX < 0) {
+				bounds[i].min.x += moveX;
+			} else {
+				bounds[i].max.x += moveX;
+			}
+			if (moveY < 0) {
+				bounds[i].min.y += moveY;
+			} else {
+				bounds[i].max.y += moveY;
+			}
+		}
+	}
+
+	// Moves every slot by its own time step; inactive slots are given a step of 0 instead of a branch
+	void integrate(const physics::scalar* dt, int count) {
+		for (int i = 0; i < count; ++i) {
+			positionX[i] += velocityX[i] * dt[i];
+			positionY[i] += velocityY[i] * dt[i];
+		}
+	}
+};
+
+typedef BodyArrays<MAX_NUM_BALLS> BallArrays;
+typedef BodyArrays<MAX_NUM_PLAYERS> PaddleArrays;
+
+struct EntityStore {
+	BallArrays balls;
+	PaddleArrays paddles;
+};
+
+#endif
\ No newline at end of file
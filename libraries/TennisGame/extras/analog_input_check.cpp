@@ -0,0 +1,193 @@
+// Drives a paddle from a made-up knob, the old way and through AnalogInput, and checks that the filtered, predicted
+// input follows the knob more closely and keeps the paddle still when the knob is.
+//
+//   analog_input_check
+//
+// Each knob signal is a position over time, read as a noisy 10-bit value at the sketch's 500Hz input rate.
+// The paddle moves at the physics rate at the speed it's given, up to the sketch's top paddle speed. The old way
+// is the sketch's first readInput(): the newest reading mapped to a whole unit with map(), then a dead zone.
+
+#include <cmath>
+#include <cstdio>
+
+#include "analoginput.h"
+#include "game.h"
+#include "prng.h"
+
+namespace {
+
+	const unsigned long INPUT_PERIOD = 1000000 / 500;
+	const double PHYSICS_PERIOD = 1000000.0 / PHYSICS_STEP_RATE;
+	const unsigned long SECONDS = 20;
+
+	// The sketch's knobs span the 24 rows and its paddles move at most this fast
+	const float RANGE = 23;
+	const float MAX_SPEED = 100;
+	const float RESPONSE_TIME = 1.0f / 60;
+
+	// Standard deviation of the ADC's noise, in counts
+	const double NOISE = 3.0;
+
+	const double PI = 3.14159265358979;
+
+	enum Signal {
+		SIGNAL_STILL,
+		SIGNAL_SLOW,
+		SIGNAL_FAST,
+		SIGNAL_FLICKS,
+		NUM_SIGNALS
+	};
+
+	const char* signalNames[] = {"still", "slow sine", "fast sine", "flicks"};
+
+	// Where the knob is at a time, in units
+	double knob(Signal signal, double seconds) {
+		switch (signal) {
+			case SIGNAL_STILL:
+				// Right on a boundary between two of map()'s whole units
+				return 12.0;
+			case SIGNAL_SLOW:
+				return 11.5 + 6 * std::sin(2 * PI * 0.5 * seconds);
+			case SIGNAL_FAST:
+				return 11.5 + 8 * std::sin(2 * PI * 2 * seconds);
+			default: {
+				// A flick from one side to the other every second, taking 80ms
+				double phase = std::fmod(seconds, 2.0);
+				double ramp = phase < 1 ? phase : phase - 1;
+				double t = ramp < 0.08 ? ramp / 0.08 : 1;
+				double from = phase < 1 ? 5 : 18;
+				double to = phase < 1 ? 18 : 5;
+				return from + (to - from) * (3 * t * t - 2 * t * t * t);
+			}
+		}
+	}
+
+	// Reads the knob through a noisy 10-bit ADC
+	class SyntheticSource : public AnalogSource {
+	public:
+		SyntheticSource(Signal _signal) : signal(_signal), now(0), noise(7) {}
+
+		int read(int channel) {
+			// Box-Muller
+			double u = (noise.next() + 1.0) / 4294967297.0;
+			double v = (noise.next() + 1.0) / 4294967297.0;
+			double gaussian = std::sqrt(-2 * std::log(u)) * std::cos(2 * PI * v);
+			long value = std::lround(knob(signal, now / 1000000.0) / RANGE * ANALOG_FULL_SCALE + gaussian * NOISE);
+			return value < 0 ? 0 : value > ANALOG_FULL_SCALE ? ANALOG_FULL_SCALE : value;
+		}
+
+		Signal signal;
+		unsigned long now;
+
+	private:
+		Prng noise;
+	};
+
+	// Arduino's map(), whole numbers only
+	long map(long x, long inMin, long inMax, long outMin, long outMax) {
+		return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+	}
+
+	float oldSpeed(int value, float paddle) {
+		float distance = map(value, 0, 1023, 0, 23) - paddle;
+		if (distance >= 0) {
+			if (distance < 1) {
+				distance = 0;
+			} else if (distance < 2) {
+				distance = 1;
+			}
+		} else {
+			if (distance > -1) {
+				distance = 0;
+			} else if (distance > -2) {
+				distance = -1;
+			}
+		}
+		return distance / RESPONSE_TIME;
+	}
+
+	struct Result {
+		double rmsError;
+		double maxError;
+
+		// Times the row the paddle is drawn on changed
+		unsigned long rowChanges;
+	};
+
+	Result run(Signal signal, bool filtered) {
+		Result result = {0, 0, 0};
+		SyntheticSource source(signal);
+		AnalogInput input(&source, 1);
+		input.setRange(0, RANGE);
+		input.setResponseTime(RESPONSE_TIME);
+		PlayerController controller;
+
+		float paddle = knob(signal, 0);
+		int row = std::lround(paddle);
+		int lastValue = source.read(0);
+		unsigned long nextSample = 0;
+		double squared = 0;
+		unsigned long steps = 0;
+
+		for (double step = 0; step < SECONDS * 1000000.0; step += PHYSICS_PERIOD) {
+			unsigned long now = (unsigned long)step;
+			while (nextSample <= now) {
+				source.now = nextSample;
+				if (filtered) {
+					input.sample(nextSample);
+				} else {
+					lastValue = source.read(0);
+				}
+				nextSample += INPUT_PERIOD;
+			}
+
+			// Steered for where the knob will be when this step ends
+			unsigned long end = (unsigned long)(step + PHYSICS_PERIOD);
+			if (filtered) {
+				input.update();
+				input.steer(0, paddle, end, controller);
+			} else {
+				controller.setSpeed(oldSpeed(lastValue, paddle));
+			}
+			float speed = controller.getSpeed();
+			speed = speed > MAX_SPEED ? MAX_SPEED : speed < -MAX_SPEED ? -MAX_SPEED : speed;
+			paddle += speed * (float)(PHYSICS_PERIOD / 1000000.0);
+
+			double error = std::fabs(paddle - knob(signal, end / 1000000.0));
+			squared += error * error;
+			if (error > result.maxError) {
+				result.maxError = error;
+			}
+			++steps;
+			if (std::lround(paddle) != row) {
+				row = std::lround(paddle);
+				++result.rowChanges;
+			}
+		}
+		result.rmsError = std::sqrt(squared / steps);
+		return result;
+	}
+
+	void report(Signal signal, const char* name, const Result& result) {
+		std::printf("%-10s %-9s paddle off the knob by %5.2f rms %5.2f max, %5lu row changes\n", signalNames[signal], name, result.rmsError, result.maxError, result.rowChanges);
+	}
+}
+
+int main() {
+	bool passed = true;
+	for (int i = 0; i < NUM_SIGNALS; ++i) {
+		Signal signal = (Signal)i;
+		Result old = run(signal, false);
+		Result filtered = run(signal, true);
+		report(signal, "map()", old);
+		report(signal, "filtered", filtered);
+
+		// Closer to the knob on every signal, and a still knob leaves the paddle on one row
+		passed = passed && filtered.rmsError < old.rmsError;
+		if (signal == SIGNAL_STILL) {
+			passed = passed && filtered.rowChanges == 0;
+		}
+	}
+	std::printf("%s\n", passed ? "ok" : "FAILED");
+	return passed ? 0 : 1;
+}
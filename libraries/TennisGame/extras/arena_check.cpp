@@ -0,0 +1,146 @@
+// Builds a sound arena blob in memory, then damages its header and sections one way at a time and checks that
+// Arena::load() turns each down with the right error rather than reading past the blob.
+//
+//   arena_check
+//
+// Build with -fsanitize=address to have any read outside the blob stop the check.
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+
+#include "arena.h"
+
+namespace {
+
+	// Header, the game's walls and two paddles, with room to spare after the end
+	struct Blob {
+		ArenaHeader header;
+		ArenaWall horizontalWalls[NUM_HORIZONTAL_WALLS];
+		ArenaWall verticalWalls[NUM_VERTICAL_WALLS];
+		ArenaPaddle paddles[2];
+		uint8_t spare[64];
+	};
+
+	Blob soundBlob() {
+		Blob blob;
+		std::memset(&blob, 0, sizeof(blob));
+		ArenaHeader& header = blob.header;
+		header.magic = ARENA_MAGIC;
+		header.version = ARENA_VERSION;
+		header.headerSize = sizeof(ArenaHeader);
+		std::memcpy(header.name, "check", 5);
+		header.numHorizontalWalls = NUM_HORIZONTAL_WALLS;
+		header.numVerticalWalls = NUM_VERTICAL_WALLS;
+		header.numPaddles = 2;
+		header.horizontalWallOffset = offsetof(Blob, horizontalWalls);
+		header.verticalWallOffset = offsetof(Blob, verticalWalls);
+		header.segmentWallOffset = offsetof(Blob, paddles);
+		header.paddleOffset = offsetof(Blob, paddles);
+		header.ball.count = 1;
+		header.ball.diameter = 2;
+		header.speed = 1;
+		for (int i = 0; i < NUM_HORIZONTAL_WALLS; ++i) {
+			blob.horizontalWalls[i].position.y = i * 23;
+			blob.horizontalWalls[i].length = 55;
+		}
+		for (int i = 0; i < NUM_VERTICAL_WALLS; ++i) {
+			blob.verticalWalls[i].length = 3;
+		}
+		header.size = offsetof(Blob, spare);
+		header.checksum = arenaChecksum(2166136261u, &header + 1, header.size - sizeof(ArenaHeader));
+		return blob;
+	}
+
+	bool expect(const char* name, const void* data, unsigned long size, ArenaError expected) {
+		Arena arena;
+		ArenaError error = arena.load(data, size);
+		bool passed = error == expected && arena.loaded() == (expected == ARENA_OK);
+		std::printf("%-34s error %d, expected %d%s\n", name, error, expected, passed ? "" : "  FAILED");
+		return passed;
+	}
+}
+
+int main() {
+	bool passed = true;
+	const unsigned long soundSize = offsetof(Blob, spare);
+
+	Blob blob = soundBlob();
+	passed = expect("sound", &blob, soundSize, ARENA_OK) && passed;
+	passed = expect("shorter than a header", &blob, sizeof(ArenaHeader) - 4, ARENA_TOO_SMALL) && passed;
+
+	blob = soundBlob();
+	blob.header.magic ^= 1;
+	passed = expect("bad magic", &blob, soundSize, ARENA_BAD_MAGIC) && passed;
+
+	blob = soundBlob();
+	blob.header.version = ARENA_VERSION + 1;
+	passed = expect("newer version", &blob, soundSize, ARENA_BAD_VERSION) && passed;
+
+	blob = soundBlob();
+	blob.header.headerSize += ARENA_ALIGNMENT;
+	passed = expect("different header size", &blob, soundSize, ARENA_BAD_VERSION) && passed;
+
+	// Sizes the checksum mustn't be run over
+	blob = soundBlob();
+	blob.header.size = 0;
+	passed = expect("size 0", &blob, soundSize, ARENA_BAD_SIZE) && passed;
+
+	blob = soundBlob();
+	blob.header.size = sizeof(ArenaHeader) - ARENA_ALIGNMENT;
+	passed = expect("size smaller than the header", &blob, soundSize, ARENA_BAD_SIZE) && passed;
+
+	blob = soundBlob();
+	blob.header.size = soundSize + ARENA_ALIGNMENT;
+	passed = expect("size past the end of the data", &blob, soundSize, ARENA_BAD_SIZE) && passed;
+
+	blob = soundBlob();
+	blob.header.size = soundSize - 2;
+	passed = expect("unaligned size", &blob, soundSize, ARENA_BAD_SIZE) && passed;
+
+	blob = soundBlob();
+	blob.verticalWalls[1].length = 4;
+	passed = expect("changed after checksumming", &blob, soundSize, ARENA_BAD_CHECKSUM) && passed;
+
+	// Sections pointing outside the blob or into the header; the header isn't under the checksum
+	blob = soundBlob();
+	blob.header.paddleOffset = soundSize;
+	passed = expect("paddles past the end", &blob, soundSize, ARENA_BAD_SECTION) && passed;
+
+	blob = soundBlob();
+	blob.header.paddleOffset = 0xFFFFFFF0u;
+	passed = expect("paddle offset near 4GB", &blob, soundSize, ARENA_BAD_SECTION) && passed;
+
+	blob = soundBlob();
+	blob.header.horizontalWallOffset = 0;
+	passed = expect("walls over the header", &blob, soundSize, ARENA_BAD_SECTION) && passed;
+
+	blob = soundBlob();
+	blob.header.verticalWallOffset += 2;
+	passed = expect("unaligned section", &blob, soundSize, ARENA_BAD_SECTION) && passed;
+
+	blob = soundBlob();
+	blob.header.numSegmentWalls = 200;
+	passed = expect("segment walls running off the end", &blob, soundSize, ARENA_BAD_SECTION) && passed;
+
+	blob = soundBlob();
+	blob.header.ball.count = 0;
+	passed = expect("no balls", &blob, soundSize, ARENA_NO_BALLS) && passed;
+
+	blob = soundBlob();
+	blob.header.numHorizontalWalls = 1;
+	passed = expect("fewer walls than the game has", &blob, soundSize, ARENA_TOO_BIG_FOR_GAME) && passed;
+
+	blob = soundBlob();
+	blob.header.ball.count = MAX_NUM_BALLS + 1;
+	passed = expect("more balls than the game has", &blob, soundSize, ARENA_TOO_BIG_FOR_GAME) && passed;
+
+	// A blob a byte into its buffer
+	static uint32_t shifted[sizeof(Blob) / 4 + 1];
+	blob = soundBlob();
+	std::memcpy((uint8_t*)shifted + 1, &blob, soundSize);
+	passed = expect("misaligned", (uint8_t*)shifted + 1, soundSize, ARENA_MISALIGNED) && passed;
+
+	std::printf("%s\n", passed ? "ok" : "FAILED");
+	return passed ? 0 : 1;
+}
@@ -0,0 +1,300 @@
+// Compiles a text arena definition into the binary blob that Arena loads, or into a C header that puts the blob in the
+// Teensy's flash.
+//
+//   arena_compiler [-c NAME] [-o OUTPUT] DEFINITION
+//
+// Without -o the output goes to stdout. With -c the output is a header defining a 4-byte aligned const uint8_t NAME[].
+// A definition has one item a line, numbers in physics units, and # starting a comment:
+//
+//   name NAME                          up to 16 characters
+//   horizontal_wall X Y LENGTH         as many as the game has (2)
+//   vertical_wall X Y LENGTH           as many as the game has (4)
+//   segment_wall X0 Y0 X1 Y1           up to MAX_SEGMENT_WALLS
+//   paddle X Y LENGTH HEIGHT SPEED     in player order, up to MAX_NUM_PLAYERS
+//   ball X Y DIAMETER                  required
+//   ball_velocity VX VY                default 10 10
+//   ball_speedup FACTOR INTERVAL MAX   default 1.1 2.5 140
+//   balls COUNT                        default 1
+//   speed SPEED                        default 1
+//   start_delay SECONDS                default 2
+
+#include <unistd.h>
+
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "arena.h"
+
+namespace {
+
+	struct Definition {
+		std::string name;
+		std::vector<ArenaWall> horizontalWalls;
+		std::vector<ArenaWall> verticalWalls;
+		std::vector<ArenaSegmentWall> segmentWalls;
+		std::vector<ArenaPaddle> paddles;
+		ArenaBall ball;
+		bool hasBall;
+		float speed;
+		float startDelay;
+	};
+
+	struct Parser {
+		const char* path;
+		int line;
+		bool failed;
+
+		void error(const char* message) {
+			std::fprintf(stderr, "%s:%d: %s\n", path, line, message);
+			failed = true;
+		}
+
+		// Reads exactly count numbers from the rest of the line
+		bool numbers(const char* text, float* values, int count) {
+			for (int i = 0; i < count; ++i) {
+				char* end;
+				values[i] = std::strtof(text, &end);
+				if (end == text) {
+					error("expected a number");
+					return false;
+				}
+				text = end;
+			}
+			while (*text == ' ' || *text == '\t') {
+				++text;
+			}
+			if (*text) {
+				error("too many values");
+				return false;
+			}
+			return true;
+		}
+	};
+
+	bool parse(const char* path, FILE* file, Definition& definition) {
+		definition.hasBall = false;
+		definition.ball.velocity.x = 10;
+		definition.ball.velocity.y = 10;
+		definition.ball.velocityIncrease = 1.1f;
+		definition.ball.velocityIncreaseInterval = 2.5f;
+		definition.ball.maxVelocity = 140;
+		definition.ball.count = 1;
+		definition.speed = 1;
+		definition.startDelay = 2;
+
+		Parser parser = {path, 0, false};
+		char text[256];
+		while (std::fgets(text, sizeof(text), file)) {
+			++parser.line;
+			char* comment = std::strchr(text, '#');
+			if (comment) {
+				*comment = 0;
+			}
+			text[std::strcspn(text, "\r\n")] = 0;
+
+			char keyword[32];
+			int length = 0;
+			if (std::sscanf(text, " %31s%n", keyword, &length) != 1) {
+				continue;
+			}
+			const char* rest = text + length;
+			float v[5];
+
+			if (!std::strcmp(keyword, "name")) {
+				char name[64];
+				if (std::sscanf(rest, " %63s", name) != 1 || std::strlen(name) > ARENA_NAME_LENGTH) {
+					parser.error("name needs to be one word of up to 16 characters");
+				} else {
+					definition.name = name;
+				}
+			} else if (!std::strcmp(keyword, "horizontal_wall") || !std::strcmp(keyword, "vertical_wall")) {
+				if (parser.numbers(rest, v, 3)) {
+					ArenaWall wall = {{v[0], v[1]}, v[2]};
+					(keyword[0] == 'h' ? definition.horizontalWalls : definition.verticalWalls).push_back(wall);
+				}
+			} else if (!std::strcmp(keyword, "segment_wall")) {
+				if (parser.numbers(rest, v, 4)) {
+					ArenaSegmentWall wall = {{v[0], v[1]}, {v[2], v[3]}};
+					definition.segmentWalls.push_back(wall);
+				}
+			} else if (!std::strcmp(keyword, "paddle")) {
+				if (parser.numbers(rest, v, 5)) {
+					ArenaPaddle paddle = {{v[0], v[1]}, v[2], v[3], v[4]};
+					definition.paddles.push_back(paddle);
+				}
+			} else if (!std::strcmp(keyword, "ball")) {
+				if (parser.numbers(rest, v, 3)) {
+					definition.ball.spawn.x = v[0];
+					definition.ball.spawn.y = v[1];
+					definition.ball.diameter = v[2];
+					definition.hasBall = true;
+				}
+			} else if (!std::strcmp(keyword, "ball_velocity")) {
+				if (parser.numbers(rest, v, 2)) {
+					definition.ball.velocity.x = v[0];
+					definition.ball.velocity.y = v[1];
+				}
+			} else if (!std::strcmp(keyword, "ball_speedup")) {
+				if (parser.numbers(rest, v, 3)) {
+					definition.ball.velocityIncrease = v[0];
+					definition.ball.velocityIncreaseInterval = v[1];
+					definition.ball.maxVelocity = v[2];
+				}
+			} else if (!std::strcmp(keyword, "balls")) {
+				if (parser.numbers(rest, v, 1)) {
+					if (v[0] < 1 || v[0] != (int)v[0]) {
+						parser.error("balls needs a whole number of at least 1");
+					}
+					definition.ball.count = (uint32_t)v[0];
+				}
+			} else if (!std::strcmp(keyword, "speed")) {
+				if (parser.numbers(rest, v, 1)) {
+					definition.speed = v[0];
+				}
+			} else if (!std::strcmp(keyword, "start_delay")) {
+				if (parser.numbers(rest, v, 1)) {
+					definition.startDelay = v[0];
+				}
+			} else {
+				parser.error("unknown item");
+			}
+		}
+
+		parser.line = 0;
+		if (!definition.hasBall) {
+			parser.error("no ball");
+		}
+		if (definition.horizontalWalls.size() > 255 || definition.verticalWalls.size() > 255 || definition.segmentWalls.size() > 255 || definition.paddles.size() > 255) {
+			parser.error("more than 255 of one kind of item");
+		}
+		return !parser.failed;
+	}
+
+	template <typename T>
+	void append(std::vector<uint8_t>& blob, const T* items, size_t count) {
+		const uint8_t* bytes = (const uint8_t*)items;
+		blob.insert(blob.end(), bytes, bytes + count * sizeof(T));
+	}
+
+	// Header, then horizontal walls, vertical walls, segment walls and paddles; every struct's size keeps them aligned
+	std::vector<uint8_t> build(const Definition& definition) {
+		ArenaHeader header;
+		std::memset(&header, 0, sizeof(header));
+		header.magic = ARENA_MAGIC;
+		header.version = ARENA_VERSION;
+		header.headerSize = sizeof(ArenaHeader);
+		std::memcpy(header.name, definition.name.data(), definition.name.size());
+		header.numHorizontalWalls = definition.horizontalWalls.size();
+		header.numVerticalWalls = definition.verticalWalls.size();
+		header.numSegmentWalls = definition.segmentWalls.size();
+		header.numPaddles = definition.paddles.size();
+		header.ball = definition.ball;
+		header.speed = definition.speed;
+		header.startDelay = definition.startDelay;
+
+		std::vector<uint8_t> blob(sizeof(header));
+		header.horizontalWallOffset = blob.size();
+		append(blob, definition.horizontalWalls.data(), definition.horizontalWalls.size());
+		header.verticalWallOffset = blob.size();
+		append(blob, definition.verticalWalls.data(), definition.verticalWalls.size());
+		header.segmentWallOffset = blob.size();
+		append(blob, definition.segmentWalls.data(), definition.segmentWalls.size());
+		header.paddleOffset = blob.size();
+		append(blob, definition.paddles.data(), definition.paddles.size());
+
+		header.size = blob.size();
+		header.checksum = arenaChecksum(2166136261u, blob.data() + sizeof(header), blob.size() - sizeof(header));
+		std::memcpy(blob.data(), &header, sizeof(header));
+		return blob;
+	}
+
+	void writeHeader(FILE* output, const char* name, const char* source, const std::vector<uint8_t>& blob) {
+		std::fprintf(output, "// Compiled from %s by arena_compiler; edit that and compile it again rather than this\n\n", source);
+		std::string guard = name;
+		for (size_t i = 0; i < guard.size(); ++i) {
+			guard[i] = std::toupper((unsigned char)guard[i]);
+		}
+		std::fprintf(output, "#ifndef %s_ARENA_H\n#define %s_ARENA_H\n\n#include <stdint.h>\n\n", guard.c_str(), guard.c_str());
+		std::fprintf(output, "const uint8_t %s[%u] __attribute__((aligned(%d))) = {", name, (unsigned int)blob.size(), ARENA_ALIGNMENT);
+		for (size_t i = 0; i < blob.size(); ++i) {
+			std::fprintf(output, "%s0x%02x,", i % 16 ? " " : "\n\t", blob[i]);
+		}
+		std::fprintf(output, "\n};\n\n#endif\n");
+	}
+
+	void usage(const char* name) {
+		std::fprintf(stderr, "usage: %s [-c NAME] [-o OUTPUT] DEFINITION\n", name);
+	}
+}
+
+int main(int argc, char** argv) {
+	const char* headerName = 0;
+	const char* outputPath = 0;
+	int option;
+	while ((option = getopt(argc, argv, "c:o:")) != -1) {
+		switch (option) {
+			case 'c':
+				headerName = optarg;
+				break;
+			case 'o':
+				outputPath = optarg;
+				break;
+			default:
+				usage(argv[0]);
+				return 2;
+		}
+	}
+	if (optind != argc - 1) {
+		usage(argv[0]);
+		return 2;
+	}
+
+	// The blob is the structs' own bytes, so they have to be little-endian already
+	const uint32_t one = 1;
+	if (*(const uint8_t*)&one != 1) {
+		std::fprintf(stderr, "arena_compiler only runs on little-endian machines\n");
+		return 1;
+	}
+
+	const char* inputPath = argv[optind];
+	FILE* input = std::fopen(inputPath, "r");
+	if (!input) {
+		std::fprintf(stderr, "can't open %s\n", inputPath);
+		return 1;
+	}
+	Definition definition;
+	bool parsed = parse(inputPath, input, definition);
+	std::fclose(input);
+	if (!parsed) {
+		return 1;
+	}
+
+	std::vector<uint8_t> blob = build(definition);
+	Arena arena;
+	ArenaError error = arena.load(blob.data(), blob.size());
+	if (error == ARENA_TOO_BIG_FOR_GAME) {
+		std::fprintf(stderr, "%s: warning: this build's game can't play this arena; it needs %d horizontal and %d vertical walls and takes at most %d segment walls, %d paddles and %d balls\n", inputPath, NUM_HORIZONTAL_WALLS, NUM_VERTICAL_WALLS, MAX_SEGMENT_WALLS, MAX_NUM_PLAYERS, MAX_NUM_BALLS);
+	} else if (error != ARENA_OK) {
+		std::fprintf(stderr, "%s: built an arena that doesn't load (error %d)\n", inputPath, error);
+		return 1;
+	}
+
+	FILE* output = outputPath ? std::fopen(outputPath, headerName ? "w" : "wb") : stdout;
+	if (!output) {
+		std::fprintf(stderr, "can't write %s\n", outputPath);
+		return 1;
+	}
+	if (headerName) {
+		writeHeader(output, headerName, inputPath, blob);
+	} else {
+		std::fwrite(blob.data(), 1, blob.size(), output);
+	}
+	if (output != stdout) {
+		std::fclose(output);
+	}
+	return 0;
+}
@@ -0,0 +1,265 @@
+// Times the specialized static collider kernels against the generic sweep tests they replace,
+// and checks that both give the same contacts.
+//
+// Each case is a ball-sized box moving near a horizontal line, a vertical line or a still box,
+// much like the walls and stubs of the playfield. Results agree when both miss, or both hit with
+// times within TIME_TOLERANCE. Grazing cases, where the generic result flips when the box grows
+// or shrinks by MARGIN, are counted but allowed to differ.
+//
+// Segment colliders are checked the same way against the line kernels, using segments laid along
+// the same lines, and timed on those and on segments at random angles.
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "broadphase.h"
+#include "collision2d.h"
+
+using physics::fixed;
+
+namespace {
+
+	const float TIME_TOLERANCE = 0.01f;
+	const float MARGIN = 0.01f;
+
+	template <typename T>
+	struct Case {
+		physics::BasicMovingBox<T> box;
+		physics::BasicMovingBox<T> collider;
+		physics::BasicHorizontalLine<T> horizontal;
+		physics::BasicVerticalLine<T> vertical;
+		physics::BasicBounds<T> bounds;
+		physics::BasicSegment<T> segment;
+		T dt;
+	};
+
+	uint32_t rngState = 0x9E3779B9u;
+
+	float uniform(float low, float high) {
+		rngState ^= rngState << 13;
+		rngState ^= rngState >> 17;
+		rngState ^= rngState << 5;
+		return low + (high - low) * (rngState & 0xFFFFFF) / float(0xFFFFFF);
+	}
+
+	template <typename T>
+	std::vector<Case<T> > makeCases(int shape, int count) {
+		rngState = 0x9E3779B9u + shape;
+
+		std::vector<Case<T> > cases(count);
+		for (int i = 0; i < count; ++i) {
+			Case<T>& c = cases[i];
+			c.box.position = physics::basic_vector2d<T>(uniform(0, 56), uniform(0, 24));
+			c.box.extents = physics::basic_vector2d<T>(1, 1);
+			c.box.velocity = physics::basic_vector2d<T>(uniform(-140, 140), uniform(-140, 140));
+			c.dt = 1.0f / 60.0f;
+
+			physics::basic_vector2d<T> nearby = c.box.position + physics::basic_vector2d<T>(uniform(-4, 4), uniform(-4, 4));
+			c.collider.position = nearby;
+			c.collider.velocity = physics::basic_vector2d<T>();
+			switch (shape) {
+				case physics::STATIC_HORIZONTAL_LINE:
+					c.horizontal.position = nearby;
+					c.horizontal.extent = uniform(1, 28);
+					c.collider.extents = physics::basic_vector2d<T>(c.horizontal.extent, 0);
+					c.bounds = physics::lineBounds(c.horizontal);
+					c.segment = physics::makeSegment(c.bounds.min, c.bounds.max);
+					break;
+				case physics::STATIC_VERTICAL_LINE:
+					c.vertical.position = nearby;
+					c.vertical.extent = uniform(0.5f, 3);
+					c.collider.extents = physics::basic_vector2d<T>(0, c.vertical.extent);
+					c.bounds = physics::lineBounds(c.vertical);
+					c.segment = physics::makeSegment(c.bounds.min, c.bounds.max);
+					break;
+				default:
+					c.collider.extents = physics::basic_vector2d<T>(uniform(0.5f, 1), uniform(1, 3));
+					c.bounds = physics::boxBounds(c.collider);
+					c.segment = physics::makeSegment(nearby, nearby + physics::basic_vector2d<T>(uniform(-6, 6), uniform(-6, 6)));
+			}
+		}
+		return cases;
+	}
+
+	template <typename T>
+	bool generic(int shape, const Case<T>& c, T& time) {
+		physics::basic_vector2d<T> position;
+		physics::basic_vector2d<T> positionOfCollider;
+		switch (shape) {
+			case physics::STATIC_HORIZONTAL_LINE:
+				return physics::movingBoxCollidesWithHorizontalLine(c.dt, c.box, c.horizontal, position, time);
+			case physics::STATIC_VERTICAL_LINE:
+				return physics::movingBoxCollidesWithVerticalLine(c.dt, c.box, c.vertical, position, time);
+			default:
+				return physics::movingBoxesCollide(c.dt, c.box, c.collider, position, positionOfCollider, time);
+		}
+	}
+
+	template <int Shape, typename T>
+	bool specialized(const Case<T>& c, T& time) {
+		physics::basic_vector2d<T> position;
+		return physics::movingBoxCollidesWithStatic<Shape>(c.dt, c.box, c.bounds, position, time);
+	}
+
+	template <typename T>
+	bool segment(const Case<T>& c, T& time) {
+		physics::basic_vector2d<T> position;
+		physics::basic_vector2d<T> normal;
+		return physics::movingBoxCollidesWithSegment(c.dt, c.box, c.segment, position, time, normal);
+	}
+
+	template <typename T>
+	bool grazing(int shape, Case<T> c) {
+		T time;
+		c.box.extents = physics::basic_vector2d<T>(1.0f + MARGIN, 1.0f + MARGIN);
+		bool grown = generic(shape, c, time);
+		c.box.extents = physics::basic_vector2d<T>(1.0f - MARGIN, 1.0f - MARGIN);
+		return grown != generic(shape, c, time);
+	}
+
+	template <int Shape, typename T>
+	bool compare(const char* name, const std::vector<Case<T> >& cases) {
+		int hits = 0;
+		int grazes = 0;
+		int mismatches = 0;
+		for (size_t i = 0; i < cases.size(); ++i) {
+			T genericTime = T(0);
+			T specializedTime = T(0);
+			bool genericHit = generic(Shape, cases[i], genericTime);
+			bool specializedHit = specialized<Shape>(cases[i], specializedTime);
+
+			if (genericHit != specializedHit) {
+				if (grazing(Shape, cases[i])) {
+					++grazes;
+				} else {
+					++mismatches;
+				}
+			} else if (genericHit) {
+				++hits;
+				if (std::fabs(physics::toFloat(genericTime) - physics::toFloat(specializedTime)) > TIME_TOLERANCE) {
+					++mismatches;
+				}
+			}
+		}
+		std::printf("%-24s %zu cases, %d hits, %d grazing, %d mismatches\n", name, cases.size(), hits, grazes, mismatches);
+		return mismatches == 0;
+	}
+
+	template <int Shape, typename T>
+	void benchmark(const char* name, const std::vector<Case<T> >& cases, int rounds) {
+		volatile int sink = 0;
+		T time;
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (int round = 0; round < rounds; ++round) {
+			for (size_t i = 0; i < cases.size(); ++i) {
+				sink += generic(Shape, cases[i], time);
+			}
+		}
+		std::chrono::duration<double, std::nano> genericTime = std::chrono::steady_clock::now() - start;
+
+		start = std::chrono::steady_clock::now();
+		for (int round = 0; round < rounds; ++round) {
+			for (size_t i = 0; i < cases.size(); ++i) {
+				sink += specialized<Shape>(cases[i], time);
+			}
+		}
+		std::chrono::duration<double, std::nano> specializedTime = std::chrono::steady_clock::now() - start;
+
+		double tests = double(rounds) * cases.size();
+		std::printf("%-24s generic %6.2f ns/test, specialized %6.2f ns/test\n", name, genericTime.count() / tests, specializedTime.count() / tests);
+	}
+
+	// Segments laid along a horizontal or vertical line should give that line's contacts
+	template <int Shape, typename T>
+	bool compareSegments(const char* name, const std::vector<Case<T> >& cases) {
+		int hits = 0;
+		int grazes = 0;
+		int mismatches = 0;
+		for (size_t i = 0; i < cases.size(); ++i) {
+			T lineTime = T(0);
+			T segmentTime = T(0);
+			bool lineHit = specialized<Shape>(cases[i], lineTime);
+			bool segmentHit = segment(cases[i], segmentTime);
+
+			if (lineHit != segmentHit) {
+				if (grazing(Shape, cases[i])) {
+					++grazes;
+				} else {
+					++mismatches;
+				}
+			} else if (lineHit) {
+				++hits;
+				if (std::fabs(physics::toFloat(lineTime) - physics::toFloat(segmentTime)) > TIME_TOLERANCE) {
+					++mismatches;
+				}
+			}
+		}
+		std::printf("%-24s %zu cases, %d hits, %d grazing, %d mismatches\n", name, cases.size(), hits, grazes, mismatches);
+		return mismatches == 0;
+	}
+
+	template <typename T>
+	void benchmarkSegments(const char* name, const std::vector<Case<T> >& cases, int rounds) {
+		volatile int sink = 0;
+		T time;
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (int round = 0; round < rounds; ++round) {
+			for (size_t i = 0; i < cases.size(); ++i) {
+				sink += segment(cases[i], time);
+			}
+		}
+		std::chrono::duration<double, std::nano> segmentTime = std::chrono::steady_clock::now() - start;
+
+		double tests = double(rounds) * cases.size();
+		std::printf("%-24s segment %6.2f ns/test\n", name, segmentTime.count() / tests);
+	}
+
+	template <typename T>
+	bool run(const char* scalarName, int count, int rounds) {
+		char name[64];
+		bool passed = true;
+
+		std::vector<Case<T> > horizontal = makeCases<T>(physics::STATIC_HORIZONTAL_LINE, count);
+		std::vector<Case<T> > vertical = makeCases<T>(physics::STATIC_VERTICAL_LINE, count);
+		std::vector<Case<T> > box = makeCases<T>(physics::STATIC_BOX, count);
+
+		std::snprintf(name, sizeof(name), "%s horizontal line", scalarName);
+		passed = compare<physics::STATIC_HORIZONTAL_LINE>(name, horizontal) && passed;
+		benchmark<physics::STATIC_HORIZONTAL_LINE>(name, horizontal, rounds);
+
+		std::snprintf(name, sizeof(name), "%s vertical line", scalarName);
+		passed = compare<physics::STATIC_VERTICAL_LINE>(name, vertical) && passed;
+		benchmark<physics::STATIC_VERTICAL_LINE>(name, vertical, rounds);
+
+		std::snprintf(name, sizeof(name), "%s static box", scalarName);
+		passed = compare<physics::STATIC_BOX>(name, box) && passed;
+		benchmark<physics::STATIC_BOX>(name, box, rounds);
+
+		std::snprintf(name, sizeof(name), "%s horizontal segment", scalarName);
+		passed = compareSegments<physics::STATIC_HORIZONTAL_LINE>(name, horizontal) && passed;
+		benchmarkSegments(name, horizontal, rounds);
+
+		std::snprintf(name, sizeof(name), "%s vertical segment", scalarName);
+		passed = compareSegments<physics::STATIC_VERTICAL_LINE>(name, vertical) && passed;
+		benchmarkSegments(name, vertical, rounds);
+
+		std::snprintf(name, sizeof(name), "%s angled segment", scalarName);
+		benchmarkSegments(name, box, rounds);
+
+		return passed;
+	}
+}
+
+int main(int argc, char** argv) {
+	int count = argc > 1 ? std::atoi(argv[1]) : 100000;
+
+	bool passed = run<float>("float", count, 20);
+	passed = run<fixed>("fixed", count, 20) && passed;
+
+	return passed ? 0 : 1;
+}
@@ -0,0 +1,34 @@
+// The court from TeensyTennis.ino, shared by the tools that play whole matches; the walls are ClassicCourtConfig's
+
+#ifndef COURT_H
+#define COURT_H
+
+#include "game.h"
+
+inline GameSettings courtSettings() {
+	GameSettings settings;
+	ClassicCourtConfig::applyCourt(settings);
+
+	settings.playerInitialPoint[0] = physics::vector2d(4, 9);
+	settings.playerInitialPoint[1] = physics::vector2d(50, 9);
+	settings.playerInitialPoint[2] = physics::vector2d(35, 9);
+	settings.playerInitialPoint[3] = physics::vector2d(19, 9);
+	for (int i = 0; i < MAX_NUM_PLAYERS; ++i) {
+		settings.playerLength[i] = 1;
+		settings.playerHeight[i] = 5;
+		settings.playerMaxMoveSpeed[i] = 100.0f;
+	}
+
+	settings.numBalls = 1;
+	settings.ballInitialPoint = physics::vector2d(26, 11);
+	settings.ballDiameter = 2;
+	settings.ballInitialVelocity = physics::vector2d(10.0f, 10.0f);
+	settings.ballVelocityIncrease = 1.1f;
+	settings.ballVelocityIncreaseInterval = 2.5f;
+	settings.maxBallVelocity = 140.0f;
+	settings.speed = 1.0f;
+	settings.startDelay = 2.0f;
+	return settings;
+}
+
+#endif
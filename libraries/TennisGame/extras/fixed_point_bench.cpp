@@ -0,0 +1,260 @@
+// Compares the float and Q16.16 instantiations of the collision tests.
+//
+// The differential check runs the same randomized, playfield-sized sweep tests through both scalar
+// types and fails if they disagree by more than the tolerances below. Cases where the float result
+// itself flips when the boxes grow or shrink by MARGIN are grazing contacts and are only counted.
+// The benchmark then times both paths. The host has an FPU, so its numbers only show the relative
+// cost; the ones that matter for the Teensy come from running the same loop on the board.
+//
+// inverseSqrt, used for the paddle rebound, is checked against the exact value over the range of
+// squared speeds the game produces, and every operation is checked to saturate at the ends of the range.
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "collision2d.h"
+
+using physics::fixed;
+
+namespace {
+
+	const float TIME_TOLERANCE = 0.01f;
+	const float POSITION_TOLERANCE = 0.02f;
+	const float MARGIN = 0.01f;
+
+	// Relative error allowed from inverseSqrt, plus a couple of Q16.16 steps for results near zero
+	const double INVERSE_SQRT_TOLERANCE = 0.0001;
+	const double INVERSE_SQRT_STEP_TOLERANCE = 2.0 / fixed::ONE;
+
+	struct Case {
+		physics::BasicMovingBox<float> a;
+		physics::BasicMovingBox<float> b;
+		float dt;
+	};
+
+	struct Result {
+		bool hit;
+		float time;
+		physics::basic_vector2d<float> positionOfA;
+	};
+
+	uint32_t rngState = 0x12345678u;
+
+	float uniform(float low, float high) {
+		rngState ^= rngState << 13;
+		rngState ^= rngState >> 17;
+		rngState ^= rngState << 5;
+		return low + (high - low) * (rngState & 0xFFFFFF) / float(0xFFFFFF);
+	}
+
+	// Ball-ish box against a paddle, a still wall or a line somewhere near it
+	Case randomCase() {
+		Case c;
+		c.a.position = physics::basic_vector2d<float>(uniform(0, 56), uniform(0, 24));
+		c.a.extents.x = c.a.extents.y = uniform(0.5f, 2.5f);
+		c.a.velocity = physics::basic_vector2d<float>(uniform(-140, 140), uniform(-140, 140));
+
+		c.b.position = c.a.position + physics::basic_vector2d<float>(uniform(-8, 8), uniform(-8, 8));
+		switch ((int)uniform(0, 3)) {
+			case 0:
+				c.b.extents = physics::basic_vector2d<float>(uniform(0, 28), 0);
+				break;
+			case 1:
+				c.b.extents = physics::basic_vector2d<float>(0, uniform(0, 3));
+				break;
+			default:
+				c.b.extents = physics::basic_vector2d<float>(uniform(0.5f, 1), uniform(1, 3));
+		}
+		c.b.velocity = physics::basic_vector2d<float>(0, uniform(0, 1) < 0.5f ? 0 : uniform(-100, 100));
+
+		c.dt = uniform(1.0f / 240.0f, 1.0f / 30.0f);
+		return c;
+	}
+
+	physics::basic_vector2d<fixed> toFixed(const physics::basic_vector2d<float>& v) {
+		return physics::basic_vector2d<fixed>(v.x, v.y);
+	}
+
+	physics::BasicMovingBox<fixed> toFixed(const physics::BasicMovingBox<float>& box) {
+		physics::BasicMovingBox<fixed> f;
+		f.position = toFixed(box.position);
+		f.extents = toFixed(box.extents);
+		f.velocity = toFixed(box.velocity);
+		return f;
+	}
+
+	Result runFloat(const Case& c, float grow) {
+		physics::BasicMovingBox<float> a = c.a;
+		physics::BasicMovingBox<float> b = c.b;
+		a.extents += physics::basic_vector2d<float>(grow, grow);
+
+		Result r;
+		physics::basic_vector2d<float> positionOfB;
+		r.time = 0;
+		r.hit = physics::movingBoxesCollide(c.dt, a, b, r.positionOfA, positionOfB, r.time);
+		return r;
+	}
+
+	Result runFixed(const Case& c) {
+		physics::basic_vector2d<fixed> positionOfA;
+		physics::basic_vector2d<fixed> positionOfB;
+		fixed time;
+
+		Result r;
+		r.hit = physics::movingBoxesCollide(fixed(c.dt), toFixed(c.a), toFixed(c.b), positionOfA, positionOfB, time);
+		r.time = time.toFloat();
+		r.positionOfA = physics::basic_vector2d<float>(positionOfA.x.toFloat(), positionOfA.y.toFloat());
+		return r;
+	}
+
+	bool differentialCheck(const std::vector<Case>& cases) {
+		int hits = 0;
+		int grazing = 0;
+		int mismatches = 0;
+		float worstTime = 0;
+		float worstPosition = 0;
+
+		for (size_t i = 0; i < cases.size(); ++i) {
+			Result f = runFloat(cases[i], 0);
+			Result q = runFixed(cases[i]);
+
+			if (f.hit != q.hit) {
+				if (runFloat(cases[i], MARGIN).hit != runFloat(cases[i], -MARGIN).hit) {
+					++grazing;
+				} else {
+					++mismatches;
+				}
+				continue;
+			}
+
+			if (!f.hit) {
+				continue;
+			}
+			++hits;
+
+			float timeError = std::fabs(f.time - q.time);
+			float positionError = std::fabs(f.positionOfA.x - q.positionOfA.x) + std::fabs(f.positionOfA.y - q.positionOfA.y);
+			if (timeError > worstTime) {
+				worstTime = timeError;
+			}
+			if (positionError > worstPosition) {
+				worstPosition = positionError;
+			}
+			if (timeError > TIME_TOLERANCE || positionError > POSITION_TOLERANCE) {
+				++mismatches;
+			}
+		}
+
+		std::printf("differential: %zu cases, %d hits, %d grazing, %d mismatches\n", cases.size(), hits, grazing, mismatches);
+		std::printf("differential: worst time error %.5f (tolerance %.3f), worst position error %.5f (tolerance %.3f)\n", worstTime, TIME_TOLERANCE, worstPosition, POSITION_TOLERANCE);
+		return mismatches == 0;
+	}
+
+	bool inverseSqrtCheck() {
+		double worstFloat = 0;
+		double worstFixed = 0;
+		int failures = 0;
+		for (double v = 1.0 / 256; v < 32000; v *= 1.001) {
+			// Each against the exact answer for the input as that scalar holds it
+			double exact = 1.0 / std::sqrt(double(float(v)));
+			double exactFixed = 1.0 / std::sqrt(double(fixed(v).toFloat()));
+			double floatError = std::fabs(physics::inverseSqrt(float(v)) - exact);
+			double fixedError = std::fabs(physics::inverseSqrt(fixed(v)).toFloat() - exactFixed);
+			if (floatError / exact > worstFloat) {
+				worstFloat = floatError / exact;
+			}
+			if (fixedError / exactFixed > worstFixed) {
+				worstFixed = fixedError / exactFixed;
+			}
+			if (floatError > exact * INVERSE_SQRT_TOLERANCE || fixedError > exactFixed * INVERSE_SQRT_TOLERANCE + INVERSE_SQRT_STEP_TOLERANCE) {
+				++failures;
+			}
+		}
+		std::printf("inverseSqrt: worst relative error float %.7f, fixed %.7f, %d failures\n", worstFloat, worstFixed, failures);
+		return failures == 0;
+	}
+
+	bool saturationCheck() {
+		const fixed largest = fixed::fromRaw(INT32_MAX);
+		const fixed smallest = fixed::fromRaw(INT32_MIN);
+		struct {
+			const char* name;
+			fixed result;
+			fixed expected;
+		} checks[] = {
+			{"max + 1", largest + fixed(1), largest},
+			{"min - 1", smallest - fixed(1), smallest},
+			{"max - min", largest - smallest, largest},
+			{"-min", -smallest, largest},
+			{"max * 2", largest * fixed(2), largest},
+			{"min * 2", smallest * fixed(2), smallest},
+			{"max / 0.5", largest / fixed(0.5f), largest},
+			{"-1 / 0", fixed(-1) / fixed(0), smallest},
+			{"int 40000", fixed(40000), largest},
+			{"int -40000", fixed(-40000), smallest},
+			{"int 32767", fixed(32767), fixed::fromRaw(32767 * fixed::ONE)},
+			{"1.5 + 2.25", fixed(1.5f) + fixed(2.25f), fixed(3.75f)}
+		};
+		int failures = 0;
+		for (size_t i = 0; i < sizeof(checks) / sizeof(checks[0]); ++i) {
+			if (checks[i].result != checks[i].expected) {
+				std::printf("saturation: %s gave raw %d, expected %d\n", checks[i].name, checks[i].result.raw, checks[i].expected.raw);
+				++failures;
+			}
+		}
+		std::printf("saturation: %d failures\n", failures);
+		return failures == 0;
+	}
+
+	template <typename T>
+	double benchmark(const std::vector<physics::BasicMovingBox<T> >& a, const std::vector<physics::BasicMovingBox<T> >& b, const std::vector<T>& dt, int rounds) {
+		physics::basic_vector2d<T> positionOfA;
+		physics::basic_vector2d<T> positionOfB;
+		T time;
+		volatile int sink = 0;
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (int round = 0; round < rounds; ++round) {
+			for (size_t i = 0; i < a.size(); ++i) {
+				sink += physics::movingBoxesCollide(dt[i], a[i], b[i], positionOfA, positionOfB, time);
+			}
+		}
+		std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+		return elapsed.count() / (double(rounds) * a.size());
+	}
+}
+
+int main(int argc, char** argv) {
+	int numCases = argc > 1 ? std::atoi(argv[1]) : 200000;
+
+	std::vector<Case> cases;
+	cases.reserve(numCases);
+	for (int i = 0; i < numCases; ++i) {
+		cases.push_back(randomCase());
+	}
+
+	bool passed = differentialCheck(cases);
+	passed = inverseSqrtCheck() && passed;
+	passed = saturationCheck() && passed;
+
+	std::vector<physics::BasicMovingBox<float> > floatA, floatB;
+	std::vector<physics::BasicMovingBox<fixed> > fixedA, fixedB;
+	std::vector<float> floatDt;
+	std::vector<fixed> fixedDt;
+	for (size_t i = 0; i < cases.size(); ++i) {
+		floatA.push_back(cases[i].a);
+		floatB.push_back(cases[i].b);
+		floatDt.push_back(cases[i].dt);
+		fixedA.push_back(toFixed(cases[i].a));
+		fixedB.push_back(toFixed(cases[i].b));
+		fixedDt.push_back(cases[i].dt);
+	}
+
+	std::printf("benchmark: float %.2f ns/test\n", benchmark(floatA, floatB, floatDt, 20));
+	std::printf("benchmark: fixed %.2f ns/test\n", benchmark(fixedA, fixedB, fixedDt, 20));
+
+	return passed ? 0 : 1;
+}
@@ -0,0 +1,164 @@
+// Paces a minute of 60Hz frames on a simulated clock, the old millis() way and with FramePacer, and checks that the
+// pacer doesn't drift, keeps its jitter within how often it's polled, and with alignment on never starts a frame while
+// the display is still sending the last one.
+//
+//   frame_pacer_check
+//
+// The loop is polled between chunks of made-up work of random length, like the scheduler's other tasks, and each frame
+// takes a fixed time to draw before show() hands it to a simulated DMA transfer that show() has to wait out if the
+// previous one is still going.
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+#include "framepacer.h"
+#include "prng.h"
+
+namespace {
+
+	const unsigned long FRAME_PERIOD = 1000000 / 60;
+	const unsigned long SECONDS = 60;
+
+	// Longest stretch of other work between two looks at the clock
+	const unsigned long MAX_WORK = 600;
+
+	// Drawing a frame before show()
+	const unsigned long DRAW_TIME = 1500;
+
+	struct Result {
+		unsigned long frames;
+		double meanInterval;
+		double jitter;
+		unsigned long maxJitter;
+		unsigned long showWait;
+		unsigned long startedWhileBusy;
+		unsigned long aligned;
+	};
+
+	struct Display {
+		unsigned long transferTime;
+		unsigned long completedAt;
+
+		bool busy(unsigned long now) const {
+			return (long)(now - (completedAt + FRAME_DISPLAY_GUARD)) < 0;
+		}
+
+		// Waits out any transfer still going, like OctoWS2811::show(), and starts the next; returns how long it waited
+		unsigned long show(unsigned long& now) {
+			unsigned long waited = 0;
+			if (busy(now)) {
+				waited = completedAt + FRAME_DISPLAY_GUARD - now;
+				now += waited;
+			}
+			completedAt = now + transferTime;
+			return waited;
+		}
+	};
+
+	void report(const char* name, const Result& result) {
+		std::printf("%-34s %5lu frames, %9.2f us apart, jitter %7.1f us rms %6lu us max, show waited %7lu us, %4lu aligned\n", name, result.frames, result.meanInterval, result.jitter, result.maxJitter, result.showWait, result.aligned);
+	}
+
+	// The sketch's first pacing: a float number of milliseconds compared against millis()
+	Result paceWithMillis(unsigned long transferTime) {
+		Result result = {};
+		Display display = {transferTime, 0};
+		Prng work(1);
+		unsigned long now = 0;
+		unsigned long lastRefresh = 0;
+		unsigned long first = 0;
+		unsigned long last = 0;
+		double squared = 0;
+		const float refreshRate = 1000.0f / 60.0f;
+		while (now < SECONDS * 1000000) {
+			if (now / 1000 - lastRefresh >= refreshRate) {
+				lastRefresh = now / 1000;
+				if (result.frames == 0) {
+					first = now;
+				} else {
+					long error = (long)(now - last) - (long)FRAME_PERIOD;
+					squared += (double)error * error;
+					if ((unsigned long)std::labs(error) > result.maxJitter) {
+						result.maxJitter = std::labs(error);
+					}
+				}
+				last = now;
+				++result.frames;
+				now += DRAW_TIME;
+				result.showWait += display.show(now);
+			}
+			now += work.below(MAX_WORK + 1);
+		}
+		result.meanInterval = (double)(last - first) / (result.frames - 1);
+		result.jitter = std::sqrt(squared / (result.frames - 1));
+		return result;
+	}
+
+	Result paceWithPacer(unsigned long transferTime, bool align) {
+		Result result = {};
+		Display display = {transferTime, 0};
+		Prng work(1);
+		unsigned long now = 0;
+		unsigned long first = 0;
+		unsigned long last = 0;
+		FramePacer pacer(60);
+		pacer.setAlignment(align);
+		pacer.start(now);
+		while (now < SECONDS * 1000000) {
+			if (align && !display.busy(now)) {
+				pacer.displayFinished(display.completedAt);
+			}
+			if (pacer.frameDue(now)) {
+				if (display.busy(now)) {
+					++result.startedWhileBusy;
+				}
+				if (result.frames == 0) {
+					first = now;
+				}
+				last = now;
+				++result.frames;
+				now += DRAW_TIME;
+				result.showWait += display.show(now);
+			}
+			now += work.below(MAX_WORK + 1);
+		}
+		const FrameStats& stats = pacer.getStats();
+		result.meanInterval = (double)(last - first) / (result.frames - 1);
+		result.jitter = pacer.jitter();
+		result.maxJitter = stats.maxJitter;
+		result.aligned = stats.aligned;
+		return result;
+	}
+}
+
+int main() {
+	bool passed = true;
+
+	// A whole frame of WS2811 data for the sketch's 168 LEDs a strip, and a display that can't keep up with 60Hz
+	const unsigned long normalTransfer = 168 * 24 * 125 / 100;
+	const unsigned long slowTransfer = FRAME_PERIOD * 5 / 4;
+
+	Result millisPacing = paceWithMillis(normalTransfer);
+	report("millis()", millisPacing);
+
+	// Never more than a poll late, and over a minute the mean interval is the period to well under a microsecond
+	Result pacer = paceWithPacer(normalTransfer, false);
+	report("pacer", pacer);
+	passed = passed && std::fabs(pacer.meanInterval - 1000000.0 / 60) < 0.5 && pacer.maxJitter <= MAX_WORK && pacer.showWait == 0;
+
+	// When the display keeps up, alignment changes nothing
+	Result aligned = paceWithPacer(normalTransfer, true);
+	report("pacer, aligned", aligned);
+	passed = passed && aligned.aligned == 0 && aligned.frames == pacer.frames && aligned.startedWhileBusy == 0;
+
+	// When it doesn't, frames without alignment start on time and then stall in show(); aligned ones start once it's free
+	Result slow = paceWithPacer(slowTransfer, false);
+	report("pacer, slow display", slow);
+	Result slowAligned = paceWithPacer(slowTransfer, true);
+	report("pacer, slow display, aligned", slowAligned);
+	passed = passed && slow.showWait > 0 && slowAligned.showWait == 0 && slowAligned.startedWhileBusy == 0 && slowAligned.aligned > 0;
+
+	std::printf("%s\n", passed ? "ok" : "FAILED");
+	return passed ? 0 : 1;
+}
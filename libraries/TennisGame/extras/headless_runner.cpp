@@ -0,0 +1,167 @@
+// Plays whole matches on the court from TeensyTennis.ino with no display, as fast as the CPU allows,
+// and reports the tick rate along with rally lengths and collision counts. Run it before and after a
+// physics change to see what the change costs and whether it plays differently.
+//
+//   headless_runner [-m MATCHES] [-p POINTS] [-n PLAYERS] [-b BALLS] [-c chase|script|intercept] [-s SEED] [-j THREADS] [-l SECONDS] [-a ARENA]
+//
+// A match runs at the fixed physics step until one side has POINTS points or SECONDS of game time have
+// passed. "chase" players follow the ball like a person would, a little late and off; "script" players
+// sweep up and down on a fixed pattern whatever the ball does; "intercept" players are InterceptController. Match i is seeded with SEED + i and the
+// results are added up in match order, so the numbers only depend on the options, not the thread count.
+// With -a the court's walls, spawns and tuning come from a compiled arena file instead, mapped and used in place.
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "arena.h"
+#include "game.h"
+#include "court.h"
+#include "match.h"
+#include "work_stealing_pool.h"
+
+namespace {
+
+	const float FRAME_TIME = 1.0f / PHYSICS_STEP_RATE;
+
+	const char* controllerNames[] = {"chase", "script", "intercept"};
+
+	struct RunOptions {
+		int matches;
+		MatchOptions match;
+		uint32_t seed;
+		int threads;
+	};
+
+	void report(const RunOptions& options, const MatchResults& total, double seconds) {
+		double gameSeconds = total.ticks * FRAME_TIME;
+		std::printf("%d matches to %d, %d players, %d balls, %s, %d threads\n", options.matches, options.match.points, options.match.players, options.match.balls, controllerNames[options.match.controllers], options.threads);
+		std::printf("%lu ticks (%.0f game seconds) in %.3f s: %.2f M ticks/s, %.0f x real time, %.0f ns/tick per thread\n", total.ticks, gameSeconds, seconds, total.ticks / seconds / 1e6, gameSeconds / seconds, seconds * options.threads / total.ticks * 1e9);
+		std::printf("wins left %u right %u, %u unfinished\n", total.leftWins, total.rightWins, total.unfinished);
+
+		std::printf("%u points, rally avg %.2f max %u paddle hits\n", total.points, total.points ? (double)total.rallyHits / total.points : 0.0, total.longestRally);
+		for (int i = 0; i < RALLY_BUCKETS; ++i) {
+			if (!total.rallies[i]) {
+				continue;
+			}
+			unsigned int low = i ? 1u << (i - 1) : 0;
+			unsigned int high = i ? (1u << i) - 1 : 0;
+			char range[24];
+			if (i == RALLY_BUCKETS - 1) {
+				std::snprintf(range, sizeof(range), "%u+", low);
+			} else if (low == high) {
+				std::snprintf(range, sizeof(range), "%u", low);
+			} else {
+				std::snprintf(range, sizeof(range), "%u-%u", low, high);
+			}
+			std::printf("  %-8s %8u  %5.1f%%\n", range, total.rallies[i], 100.0 * total.rallies[i] / total.points);
+		}
+
+		std::printf("collisions: paddle %lu, vertical wall %lu, horizontal wall %lu, segment wall %lu (%.1f per game second)\n", total.collisions[CONTACT_PADDLE], total.collisions[CONTACT_VERTICAL_WALL], total.collisions[CONTACT_HORIZONTAL_WALL], total.collisions[CONTACT_SEGMENT_WALL], (total.collisions[CONTACT_PADDLE] + total.collisions[CONTACT_VERTICAL_WALL] + total.collisions[CONTACT_HORIZONTAL_WALL] + total.collisions[CONTACT_SEGMENT_WALL]) / gameSeconds);
+		std::printf("contact limit hits %u, tunneling events %u, dropped collision events %u\n", total.contactLimitHits, total.tunnelingEvents, total.droppedCollisionEvents);
+	}
+
+	// Maps an arena file and writes it over settings; the mapping is left for the process to clean up
+	bool applyArenaFile(const char* path, GameSettings& settings) {
+		int file = open(path, O_RDONLY);
+		struct stat status;
+		if (file < 0 || fstat(file, &status) != 0 || status.st_size == 0) {
+			std::fprintf(stderr, "can't open %s\n", path);
+			return false;
+		}
+		void* data = mmap(0, status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+		close(file);
+		if (data == MAP_FAILED) {
+			std::fprintf(stderr, "can't map %s\n", path);
+			return false;
+		}
+
+		Arena arena;
+		ArenaError error = arena.load(data, status.st_size);
+		if (error != ARENA_OK) {
+			std::fprintf(stderr, "%s isn't an arena this build can play (error %d)\n", path, error);
+			return false;
+		}
+		arena.apply(settings);
+		std::printf("arena %.*s from %s\n", ARENA_NAME_LENGTH, arena.header().name, path);
+		return true;
+	}
+
+	void usage(const char* name) {
+		std::fprintf(stderr, "usage: %s [-m MATCHES] [-p POINTS] [-n PLAYERS] [-b BALLS] [-c chase|script|intercept] [-s SEED] [-j THREADS] [-l SECONDS] [-a ARENA]\n", name);
+	}
+}
+
+int main(int argc, char** argv) {
+	RunOptions options;
+	options.matches = 100;
+	options.match.points = 11;
+	options.match.maxSeconds = 600;
+	options.match.players = 2;
+	options.match.balls = 1;
+	options.match.controllers = CONTROLLERS_CHASE;
+	options.seed = 1;
+	options.threads = 1;
+	const char* arenaPath = 0;
+
+	int option;
+	while ((option = getopt(argc, argv, "m:p:n:b:c:s:j:l:a:")) != -1) {
+		switch (option) {
+			case 'm': options.matches = std::atoi(optarg); break;
+			case 'p': options.match.points = std::atoi(optarg); break;
+			case 'n': options.match.players = std::atoi(optarg); break;
+			case 'b': options.match.balls = std::atoi(optarg); break;
+			case 's': options.seed = std::strtoul(optarg, 0, 0); break;
+			case 'j': options.threads = std::atoi(optarg); break;
+			case 'l': options.match.maxSeconds = std::atoi(optarg); break;
+			case 'a': arenaPath = optarg; break;
+			case 'c':
+				if (std::strcmp(optarg, "chase") == 0) {
+					options.match.controllers = CONTROLLERS_CHASE;
+				} else if (std::strcmp(optarg, "script") == 0) {
+					options.match.controllers = CONTROLLERS_SCRIPT;
+				} else if (std::strcmp(optarg, "intercept") == 0) {
+					options.match.controllers = CONTROLLERS_INTERCEPT;
+				} else {
+					usage(argv[0]);
+					return 1;
+				}
+				break;
+			default:
+				usage(argv[0]);
+				return 1;
+		}
+	}
+	if (optind != argc || options.matches < 1 || options.match.points < 1 || options.match.players < 1 || options.match.players > MAX_NUM_PLAYERS || options.match.balls < 1 || options.match.balls > MAX_NUM_BALLS || options.threads < 1 || options.match.maxSeconds < 1) {
+		usage(argv[0]);
+		return 1;
+	}
+
+	GameSettings settings = courtSettings();
+	if (arenaPath && !applyArenaFile(arenaPath, settings)) {
+		return 1;
+	}
+
+	std::vector<MatchResults> results(options.matches);
+	WorkStealingPool pool(options.threads);
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	pool.run(options.matches, [&](int match) {
+		results[match] = playMatch(settings, options.match, options.seed + match);
+	});
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	MatchResults total;
+	std::memset(&total, 0, sizeof(total));
+	for (int i = 0; i < options.matches; ++i) {
+		addMatchResults(total, results[i]);
+	}
+	report(options, total, seconds);
+	return total.tunnelingEvents == 0 ? 0 : 1;
+}
@@ -0,0 +1,190 @@
+// Checks the interrupt-to-loop input path: InputEdgeQueue under real concurrent producers, and ButtonDebouncer
+// against a bouncing, glitching button on a simulated clock, next to the sketch's first flag-and-debounce handler.
+//
+//   input_event_check
+//
+// The concurrency half runs a thread per simulated interrupt handler, each pushing numbered edges into its own queue
+// as fast as it can, while the loop thread drains them all; every edge has to arrive once and in order, or be counted
+// as dropped. The button half scripts presses with contact bounce and IR glitches, delivers the edges the way the pin
+// interrupt would, and has the loop take them at the physics rate.
+
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "game.h"
+#include "inputevents.h"
+#include "prng.h"
+
+namespace {
+
+	const int NUM_PRODUCERS = 3;
+	const unsigned long EDGES_PER_PRODUCER = 500000;
+
+	const unsigned long PHYSICS_PERIOD = 1000000 / PHYSICS_STEP_RATE;
+	const unsigned long OLD_POLL_PERIOD = 1000000 / 500;
+	const unsigned long NUM_PRESSES = 2000;
+
+	bool checkConcurrentQueues() {
+		std::vector<InputEdgeQueue> queues(NUM_PRODUCERS);
+		std::atomic<int> running(NUM_PRODUCERS);
+		std::vector<std::thread> producers;
+		for (int i = 0; i < NUM_PRODUCERS; ++i) {
+			producers.push_back(std::thread([&, i]() {
+				// Every so often the handler goes quiet for a bit, as interrupts do, so not everything overflows
+				for (unsigned long n = 1; n <= EDGES_PER_PRODUCER; ++n) {
+					queues[i].push(i, n & 1, n);
+					if (n % 16 == 0) {
+						std::this_thread::yield();
+					}
+				}
+				--running;
+			}));
+		}
+
+		unsigned long received[NUM_PRODUCERS] = {};
+		unsigned long last[NUM_PRODUCERS] = {};
+		bool ordered = true;
+		bool draining = true;
+		while (draining) {
+			draining = running > 0;
+			bool idle = true;
+			for (int i = 0; i < NUM_PRODUCERS; ++i) {
+				InputEdge edge;
+				while (queues[i].pop(edge)) {
+					idle = false;
+					if (edge.source != i || edge.time <= last[i] || edge.down != (bool)(edge.time & 1)) {
+						ordered = false;
+					}
+					last[i] = edge.time;
+					++received[i];
+				}
+			}
+
+			// On a machine with fewer cores than threads the producers need the loop to let them run
+			if (idle) {
+				std::this_thread::yield();
+			}
+		}
+		for (int i = 0; i < NUM_PRODUCERS; ++i) {
+			producers[i].join();
+		}
+
+		bool passed = ordered;
+		for (int i = 0; i < NUM_PRODUCERS; ++i) {
+			std::printf("producer %d: %lu edges, %lu received, %lu dropped\n", i, EDGES_PER_PRODUCER, received[i], (unsigned long)queues[i].dropped);
+			passed = passed && received[i] + queues[i].dropped == EDGES_PER_PRODUCER && received[i] > 0;
+		}
+		std::printf("edges %s\n", ordered ? "in order" : "OUT OF ORDER");
+		return passed;
+	}
+
+	struct ScriptedEdge {
+		unsigned long time;
+		bool down;
+	};
+
+	// Presses of 30 to 200ms, some only 60ms after the last release, each change of level bouncing a few times
+	// within 3ms, and now and then an IR glitch: a down and up again inside a millisecond
+	std::vector<ScriptedEdge> scriptButton(std::vector<unsigned long>& pressTimes) {
+		Prng random(5);
+		std::vector<ScriptedEdge> edges;
+		unsigned long now = 100000;
+		for (unsigned long press = 0; press < NUM_PRESSES; ++press) {
+			if (random.below(4) == 0) {
+				unsigned long glitch = now + 20000 + random.below(20000);
+				edges.push_back({glitch, true});
+				edges.push_back({glitch + 100 + random.below(800), false});
+				now = glitch + 20000;
+			}
+			pressTimes.push_back(now);
+			for (int change = 0; change < 2; ++change) {
+				bool down = change == 0;
+				unsigned long t = now;
+				edges.push_back({t, down});
+				for (int bounce = random.below(4); bounce > 0; --bounce) {
+					t += 100 + random.below(700);
+					edges.push_back({t, !down});
+					t += 100 + random.below(700);
+					edges.push_back({t, down});
+				}
+				now += down ? 30000 + random.below(170000) : 60000 + random.below(400000);
+			}
+		}
+		return edges;
+	}
+
+	bool checkDebouncer() {
+		std::vector<unsigned long> pressTimes;
+		std::vector<ScriptedEdge> script = scriptButton(pressTimes);
+		const unsigned long end = script.back().time + 100000;
+
+		// The pin interrupt pushes each edge as it happens; the loop takes them at each physics tick
+		InputEdgeQueue queue;
+		ButtonDebouncer debouncer;
+		std::vector<ButtonEvent> presses;
+		size_t next = 0;
+		unsigned long releases = 0;
+		for (unsigned long tick = 0; tick <= end; tick += PHYSICS_PERIOD) {
+			while (next < script.size() && script[next].time <= tick) {
+				queue.push(0, script[next].down, script[next].time);
+				++next;
+			}
+			InputEdge edge;
+			while (queue.pop(edge)) {
+				ButtonEvent event = debouncer.edge(edge);
+				if (event.type == BUTTON_PRESSED) {
+					presses.push_back(event);
+				} else if (event.type == BUTTON_RELEASED) {
+					++releases;
+				}
+			}
+			ButtonEvent event = debouncer.settle(tick);
+			if (event.type == BUTTON_PRESSED) {
+				presses.push_back(event);
+			} else if (event.type == BUTTON_RELEASED) {
+				++releases;
+			}
+		}
+
+		unsigned long mistimed = 0;
+		for (size_t i = 0; i < presses.size() && i < pressTimes.size(); ++i) {
+			if (presses[i].time != pressTimes[i]) {
+				++mistimed;
+			}
+		}
+
+		// The sketch's first handler: a falling edge at least 10ms after the last one that reads low sets a flag,
+		// which the input task clears at 500Hz
+		unsigned long oldPresses = 0;
+		unsigned long lastTime = 0;
+		bool flag = false;
+		next = 0;
+		for (unsigned long poll = 0; poll <= end; poll += OLD_POLL_PERIOD) {
+			while (next < script.size() && script[next].time <= poll) {
+				if (script[next].down && script[next].time - lastTime >= 10000) {
+					lastTime = script[next].time;
+					flag = true;
+				}
+				++next;
+			}
+			if (flag) {
+				flag = false;
+				++oldPresses;
+			}
+		}
+
+		std::printf("button: %lu presses scripted with bounce and glitches\n", (unsigned long)pressTimes.size());
+		std::printf("  flag     %5lu presses seen, timing lost\n", oldPresses);
+		std::printf("  debounce %5lu presses seen, %lu releases, %lu not at the first edge of their bounce, %lu edges dropped\n", (unsigned long)presses.size(), releases, mistimed, (unsigned long)queue.dropped);
+		return presses.size() == pressTimes.size() && releases == pressTimes.size() && mistimed == 0 && queue.dropped == 0;
+	}
+}
+
+int main() {
+	bool passed = checkConcurrentQueues();
+	passed = checkDebouncer() && passed;
+	std::printf("%s\n", passed ? "ok" : "FAILED");
+	return passed ? 0 : 1;
+}
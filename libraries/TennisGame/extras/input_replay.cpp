@@ -0,0 +1,211 @@
+// Replays an input log and checks the state hash after every tick.
+//
+//   input_replay LOG     replays a log, e.g. one captured from the Teensy's USB serial port
+//   input_replay         records a few scripted rounds in memory and checks that they replay, and that
+//                        changing one input is caught at the tick it was changed
+//
+// Replays run as fast as the host can tick, which makes them useful for profiling and for bisecting a
+// desync down to the tick it starts at.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "game.h"
+#include "inputlog.h"
+#include "court.h"
+
+namespace {
+
+	class MemoryLogWriter : public InputLogWriter {
+	public:
+		void write(const void* data, int size) {
+			const uint8_t* bytes = (const uint8_t*)data;
+			log.insert(log.end(), bytes, bytes + size);
+		}
+
+		std::vector<uint8_t> log;
+	};
+
+	// Two players chasing the ball a little late, over a few rounds with a button press switching to four players and more balls halfway
+	std::vector<uint8_t> recordMatch(unsigned int ticks) {
+		static Game game(56, 24, 1);
+		game.setup(courtSettings());
+		game.seed(12345);
+		game.deactivatePlayer(2);
+		game.deactivatePlayer(3);
+
+		PlayerController controller[MAX_NUM_PLAYERS];
+		for (int i = 0; i < MAX_NUM_PLAYERS; ++i) {
+			game.assignController(i, &controller[i]);
+		}
+
+		MemoryLogWriter writer;
+		InputRecorder recorder(&writer);
+		game.record(&recorder);
+
+		for (unsigned int t = 0; t < ticks; ++t) {
+			if (t == ticks / 2) {
+				recorder.button(1);
+				game.activatePlayer(2);
+				game.activatePlayer(3);
+				game.changeNumberOfBalls(4);
+				game.resetPlayersAndBall();
+			}
+
+			// New input at 60Hz, the way the sketch reads it, while physics runs at PHYSICS_STEP_RATE
+			if (t % (PHYSICS_STEP_RATE / 60) == 0) {
+				for (int i = 0; i < MAX_NUM_PLAYERS; ++i) {
+					float distance = game.YpositionOfBall() - 1 - (game.YpositionOfPlayer(i) - 2.5f);
+					controller[i].setSpeed(distance * (3 + i));
+				}
+			}
+			game.tick(1.0f / PHYSICS_STEP_RATE);
+
+			if (game.winCondition()) {
+				game.resetPlayersAndBall();
+			}
+		}
+
+		game.record(0);
+		return writer.log;
+	}
+
+	InputReplayResult replay(InputReplay& replay, double& seconds) {
+		GameUtility utility;
+		GameSettings settings;
+		if (!replay.begin(utility, settings)) {
+			return REPLAY_CORRUPT;
+		}
+		Game* game = new Game(utility.screenWidth, utility.screenHeight, utility.physicsToPixelRatio);
+		game->setup(settings);
+
+		InputReplayResult result;
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		do {
+			result = replay.step(*game);
+		} while (result == REPLAY_TICKED);
+		seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		delete game;
+		return result;
+	}
+
+	const char* resultName(InputReplayResult result) {
+		switch (result) {
+			case REPLAY_TICKED: return "ticked";
+			case REPLAY_FINISHED: return "finished";
+			case REPLAY_DESYNC: return "desync";
+			case REPLAY_CORRUPT: return "corrupt";
+		}
+		return "?";
+	}
+
+	void report(const char* name, InputReplayResult result, const InputReplay& replayed, double seconds) {
+		std::printf("%-20s %-8s %u ticks, %u button presses, %.0f ticks/s", name, resultName(result), replayed.ticks, replayed.buttons, replayed.ticks / seconds);
+		if (result == REPLAY_DESYNC) {
+			std::printf(", first bad tick %u", replayed.desyncTick);
+		}
+		std::printf("\n");
+	}
+
+	// Finds the first tick record at or after the given tick that logs a new speed for player 1, and turns it around, returning the game tick it belongs to
+	// Player 1 is always active, so the change has to show up in that tick's state; leaves the log alone and returns 0 if there's no such record
+	unsigned int tamper(std::vector<uint8_t>& log, unsigned int fromTick) {
+		size_t offset = sizeof(uint32_t) + sizeof(uint16_t) + 2 * sizeof(uint8_t) + 2 * sizeof(uint16_t) + 3 * sizeof(int16_t) + sizeof(GameSettings);
+		unsigned int tick = 0;
+		while (offset < log.size()) {
+			uint8_t type = log[offset++];
+			if (type == INPUT_LOG_STEP_SIZE) {
+				offset += sizeof(float);
+			} else if (type == INPUT_LOG_KEYFRAME) {
+				GameSnapshot snapshot;
+				std::memcpy(&snapshot, &log[offset + 1], sizeof(snapshot));
+				tick = snapshot.stats.tick;
+				offset += 1 + sizeof(GameSnapshot);
+			} else if (type == INPUT_LOG_BUTTON) {
+				offset += 1;
+			} else {
+				++tick;
+				uint8_t changed = log[offset++];
+				if ((changed & 1) && tick >= fromTick) {
+					float speed;
+					std::memcpy(&speed, &log[offset], sizeof(speed));
+					speed = -speed - 7;
+					std::memcpy(&log[offset], &speed, sizeof(speed));
+					return tick;
+				}
+				for (int i = 0; i < MAX_NUM_PLAYERS; ++i) {
+					if (changed & (1 << i)) {
+						offset += sizeof(float);
+					}
+				}
+				offset += sizeof(uint32_t);
+			}
+		}
+		return 0;
+	}
+
+	bool selfTest() {
+		const unsigned int ticks = 60 * PHYSICS_STEP_RATE;
+		std::vector<uint8_t> log = recordMatch(ticks);
+		std::printf("recorded %u ticks in %zu bytes\n", ticks, log.size());
+
+		double seconds;
+		InputReplay clean(&log[0], log.size());
+		InputReplayResult result = replay(clean, seconds);
+		report("clean", result, clean, seconds);
+		bool passed = result == REPLAY_FINISHED && clean.ticks == ticks && clean.buttons == 1;
+
+		std::vector<uint8_t> changed = log;
+		unsigned int changedTick = tamper(changed, ticks / 3);
+		InputReplay tampered(&changed[0], changed.size());
+		result = replay(tampered, seconds);
+		report("one input changed", result, tampered, seconds);
+		std::printf("%-20s input changed at tick %u\n", "", changedTick);
+
+		// The changed speed is used for the first time in that tick, so the hash after it has to differ
+		passed = passed && changedTick && result == REPLAY_DESYNC && tampered.desyncTick == changedTick;
+
+		// Missing the last tick's hash
+		std::vector<uint8_t> cut(log.begin(), log.end() - 1);
+		InputReplay truncated(&cut[0], cut.size());
+		result = replay(truncated, seconds);
+		report("cut short", result, truncated, seconds);
+		passed = passed && result == REPLAY_CORRUPT && truncated.ticks == ticks - 1;
+
+		return passed;
+	}
+}
+
+int main(int argc, char** argv) {
+	if (argc < 2) {
+		return selfTest() ? 0 : 1;
+	}
+
+	FILE* file = std::fopen(argv[1], "rb");
+	if (!file) {
+		std::fprintf(stderr, "can't open %s\n", argv[1]);
+		return 1;
+	}
+	std::vector<uint8_t> log;
+	uint8_t buffer[4096];
+	size_t read;
+	while ((read = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+		log.insert(log.end(), buffer, buffer + read);
+	}
+	std::fclose(file);
+
+	if (log.empty()) {
+		std::fprintf(stderr, "%s is empty\n", argv[1]);
+		return 1;
+	}
+
+	double seconds;
+	InputReplay replayed(&log[0], log.size());
+	InputReplayResult result = replay(replayed, seconds);
+	report(argv[1], result, replayed, seconds);
+	return result == REPLAY_FINISHED ? 0 : 1;
+}
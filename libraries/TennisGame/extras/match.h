@@ -0,0 +1,198 @@
+// Whole matches between computer players, with no display, shared by the tools that play lots of them
+
+#ifndef MATCH_H
+#define MATCH_H
+
+#include <cmath>
+#include <cstring>
+
+#include "game.h"
+#include "interceptcontroller.h"
+
+// Controllers are read at 60Hz like the sketch's input
+#define MATCH_CONTROL_INTERVAL (PHYSICS_STEP_RATE / 60)
+
+// Rally lengths are counted in paddle hits, bucketed by powers of two: 0, 1, 2-3, 4-7, ...
+#define RALLY_BUCKETS 10
+
+enum MatchControllers {
+	// Follow the ball like a person would, a little late and off
+	CONTROLLERS_CHASE,
+
+	// Sweep up and down on a fixed pattern whatever the ball does
+	CONTROLLERS_SCRIPT,
+
+	// InterceptController with its default reaction delay and aim error
+	CONTROLLERS_INTERCEPT
+};
+
+struct MatchOptions {
+	// A match ends when one side has this many points, or after this much game time
+	int points;
+	int maxSeconds;
+
+	int players;
+	int balls;
+	MatchControllers controllers;
+};
+
+struct MatchResults {
+	unsigned long ticks;
+	unsigned int points;
+	unsigned int leftWins;
+	unsigned int rightWins;
+	unsigned int unfinished;
+
+	unsigned long rallyHits;
+	unsigned long long rallyHitsSquared;
+	unsigned int longestRally;
+	unsigned int rallies[RALLY_BUCKETS];
+
+	unsigned long collisions[CONTACT_SEGMENT_WALL + 1];
+	unsigned int contactLimitHits;
+	unsigned int tunnelingEvents;
+	unsigned int droppedCollisionEvents;
+};
+
+inline int rallyBucket(unsigned int hits) {
+	int bucket = 0;
+	while (hits && bucket < RALLY_BUCKETS - 1) {
+		hits >>= 1;
+		++bucket;
+	}
+	return bucket;
+}
+
+inline void addMatchResults(MatchResults& total, const MatchResults& match) {
+	total.ticks += match.ticks;
+	total.points += match.points;
+	total.leftWins += match.leftWins;
+	total.rightWins += match.rightWins;
+	total.unfinished += match.unfinished;
+	total.rallyHits += match.rallyHits;
+	total.rallyHitsSquared += match.rallyHitsSquared;
+	if (match.longestRally > total.longestRally) {
+		total.longestRally = match.longestRally;
+	}
+	for (int i = 0; i < RALLY_BUCKETS; ++i) {
+		total.rallies[i] += match.rallies[i];
+	}
+	for (int i = 0; i <= CONTACT_SEGMENT_WALL; ++i) {
+		total.collisions[i] += match.collisions[i];
+	}
+	total.contactLimitHits += match.contactLimitHits;
+	total.tunnelingEvents += match.tunnelingEvents;
+	total.droppedCollisionEvents += match.droppedCollisionEvents;
+}
+
+// Heads for the nearest ball, or the middle when there's none, aiming off by its own error for the point
+inline float chaseSpeed(Game& game, int player, float aimError) {
+	float paddleX = game.XpositionOfPlayer(player) + game.widthOfPlayer(player) / 2;
+	float paddleY = game.YpositionOfPlayer(player) - game.heightOfPlayer(player) / 2;
+	float targetY = 11;
+	float nearest = 1e9f;
+	for (int i = 0; i < game.numberOfBalls(); ++i) {
+		if (!game.ballIsActive(i)) {
+			continue;
+		}
+		float distance = std::fabs(game.XpositionOfBall(i) - paddleX);
+		if (distance < nearest) {
+			nearest = distance;
+			targetY = game.YpositionOfBall(i) - game.diameterOfBall(i) / 2;
+		}
+	}
+	return (targetY + aimError - paddleY) * 8;
+}
+
+// Up and down at full speed, turning at times that differ between players
+inline float scriptedSpeed(unsigned long tick, int player) {
+	unsigned long period = PHYSICS_STEP_RATE * (2 + player) / 2;
+	return (tick / period) % 2 ? 100.0f : -100.0f;
+}
+
+// The same settings, options and seed always play the same match
+inline MatchResults playMatch(GameSettings settings, const MatchOptions& options, uint32_t seed) {
+	const float frameTime = 1.0f / PHYSICS_STEP_RATE;
+
+	MatchResults results;
+	std::memset(&results, 0, sizeof(results));
+
+	settings.numBalls = options.balls;
+	Game* game = new Game(56, 24, 1);
+	game->setup(settings);
+	game->seed(seed);
+	InterceptController controller[MAX_NUM_PLAYERS];
+	for (int i = 0; i < MAX_NUM_PLAYERS; ++i) {
+		controller[i].bind(game, i);
+		controller[i].seed(seed * MAX_NUM_PLAYERS + i);
+		game->assignController(i, &controller[i]);
+		if (i >= options.players) {
+			game->deactivatePlayer(i);
+		}
+	}
+
+	// Aim errors are drawn again every point, from a generator of the match's own so the game's is left alone
+	Prng aim(seed ^ 0xA5A5A5A5u);
+	float aimError[MAX_NUM_PLAYERS];
+	for (int i = 0; i < MAX_NUM_PLAYERS; ++i) {
+		aimError[i] = aim.below(501) / 100.0f - 2.5f;
+	}
+
+	const unsigned long maxTicks = (unsigned long)options.maxSeconds * PHYSICS_STEP_RATE;
+	unsigned int rally = 0;
+	while (game->getStats().leftScore < options.points && game->getStats().rightScore < options.points && results.ticks < maxTicks) {
+		if (results.ticks % MATCH_CONTROL_INTERVAL == 0) {
+			for (int i = 0; i < options.players; ++i) {
+				if (options.controllers == CONTROLLERS_INTERCEPT) {
+					controller[i].update(MATCH_CONTROL_INTERVAL * frameTime);
+				} else {
+					controller[i].setSpeed(options.controllers == CONTROLLERS_CHASE ? chaseSpeed(*game, i, aimError[i]) : scriptedSpeed(results.ticks, i));
+				}
+			}
+		}
+
+		game->tick(frameTime);
+		++results.ticks;
+
+		CollisionEvent event;
+		while (game->nextCollisionEvent(event)) {
+			++results.collisions[event.type];
+			if (event.type == CONTACT_PADDLE) {
+				++rally;
+			}
+		}
+
+		if (game->winCondition()) {
+			++results.points;
+			++results.rallies[rallyBucket(rally)];
+			results.rallyHits += rally;
+			results.rallyHitsSquared += (unsigned long long)rally * rally;
+			if (rally > results.longestRally) {
+				results.longestRally = rally;
+			}
+			rally = 0;
+
+			for (int i = 0; i < MAX_NUM_PLAYERS; ++i) {
+				aimError[i] = aim.below(501) / 100.0f - 2.5f;
+			}
+			game->resetPlayersAndBall();
+		}
+	}
+
+	const GameStats& stats = game->getStats();
+	if (stats.leftScore >= options.points) {
+		++results.leftWins;
+	} else if (stats.rightScore >= options.points) {
+		++results.rightWins;
+	} else {
+		++results.unfinished;
+	}
+	results.contactLimitHits = stats.contactLimitHits;
+	results.tunnelingEvents = stats.tunnelingEvents;
+	results.droppedCollisionEvents = stats.droppedCollisionEvents;
+
+	delete game;
+	return results;
+}
+
+#endif
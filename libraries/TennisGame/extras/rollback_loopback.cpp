@@ -0,0 +1,337 @@
+// Plays two rollback sessions against each other over UDP on 127.0.0.1.
+//
+//   rollback_loopback                      runs both sides in this process with simulated latency, jitter and
+//                                          loss, and checks both games end up in the same state
+//   rollback_loopback PLAYER PORT PEER [SECONDS] [LATENCY_MS]
+//                                          runs one side in real time, player 1 or 2, listening on PORT and
+//                                          sending to PEER; start a second process with the ports swapped
+//
+// Both print how often predictions were wrong, how far back they had to go and how many frames were run
+// again because of it.
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include "game.h"
+#include "rollback.h"
+#include "court.h"
+
+namespace {
+
+	const float FRAME_TIME = 1.0f / PHYSICS_STEP_RATE;
+
+	// Non-blocking UDP between two ports on the loopback interface
+	class UdpTransport : public NetTransport {
+	public:
+		UdpTransport() : socketFd(-1) {}
+
+		~UdpTransport() {
+			if (socketFd >= 0) {
+				close(socketFd);
+			}
+		}
+
+		// Port 0 picks a free one
+		bool open(int port) {
+			socketFd = socket(AF_INET, SOCK_DGRAM, 0);
+			if (socketFd < 0) {
+				return false;
+			}
+
+			sockaddr_in address = loopback(port);
+			if (bind(socketFd, (sockaddr*)&address, sizeof(address)) < 0) {
+				return false;
+			}
+			return fcntl(socketFd, F_SETFL, fcntl(socketFd, F_GETFL) | O_NONBLOCK) == 0;
+		}
+
+		int port() const {
+			sockaddr_in address;
+			socklen_t length = sizeof(address);
+			getsockname(socketFd, (sockaddr*)&address, &length);
+			return ntohs(address.sin_port);
+		}
+
+		void connect(int port) {
+			peer = loopback(port);
+		}
+
+		void send(const void* data, int size) {
+			sendto(socketFd, data, size, 0, (sockaddr*)&peer, sizeof(peer));
+		}
+
+		int receive(void* buffer, int size) {
+			ssize_t received = recv(socketFd, buffer, size, 0);
+			return received > 0 ? (int)received : 0;
+		}
+
+	private:
+		static sockaddr_in loopback(int port) {
+			sockaddr_in address;
+			std::memset(&address, 0, sizeof(address));
+			address.sin_family = AF_INET;
+			address.sin_port = htons(port);
+			address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+			return address;
+		}
+
+		int socketFd;
+		sockaddr_in peer;
+	};
+
+	// Holds incoming packets back by a latency plus random jitter, which also reorders them, and drops some
+	// Time is whatever the caller counts in, frames or milliseconds
+	class LaggyTransport : public NetTransport {
+	public:
+		LaggyTransport(NetTransport* _inner, int _latency, int _jitter, int _lossPercent, uint32_t seed) : inner(_inner), latency(_latency), jitter(_jitter), lossPercent(_lossPercent), now(0), random(seed) {}
+
+		void setTime(long _now) {
+			now = _now;
+		}
+
+		void send(const void* data, int size) {
+			inner->send(data, size);
+		}
+
+		int receive(void* buffer, int size) {
+			uint8_t packet[ROLLBACK_MAX_PACKET_SIZE];
+			int received;
+			while ((received = inner->receive(packet, sizeof(packet))) > 0) {
+				if ((int)random.below(100) < lossPercent) {
+					continue;
+				}
+				Delayed delayed;
+				delayed.release = now + latency + (jitter ? random.below(jitter + 1) : 0);
+				delayed.data.assign(packet, packet + received);
+				pending.push_back(delayed);
+			}
+
+			for (size_t i = 0; i < pending.size(); ++i) {
+				if (pending[i].release <= now && (int)pending[i].data.size() <= size) {
+					int length = pending[i].data.size();
+					std::memcpy(buffer, &pending[i].data[0], length);
+					pending.erase(pending.begin() + i);
+					return length;
+				}
+			}
+			return 0;
+		}
+
+	private:
+		struct Delayed {
+			long release;
+			std::vector<uint8_t> data;
+		};
+
+		NetTransport* inner;
+		int latency;
+		int jitter;
+		int lossPercent;
+		long now;
+		Prng random;
+		std::deque<Delayed> pending;
+	};
+
+	Game* makeGame() {
+		Game* game = new Game(56, 24, 1);
+		game->setup(courtSettings());
+		game->seed(777);
+		game->deactivatePlayer(2);
+		game->deactivatePlayer(3);
+		return game;
+	}
+
+	// Each side chases the ball in its own, possibly mispredicted, game; player 2 a little more eagerly, so the two differ
+	void chooseSpeeds(Game& game, int player, float* speeds) {
+		for (int i = 0; i < MAX_NUM_PLAYERS; ++i) {
+			speeds[i] = 0;
+		}
+		float distance = game.YpositionOfBall() - 1 - (game.YpositionOfPlayer(player) - 2.5f);
+
+		// Read at 60Hz like the sketch, rounded so runs of frames share a speed and the predictions are sometimes right
+		speeds[player] = (int)(distance * (3 + player));
+	}
+
+	void report(const char* name, const RollbackSession& session, double seconds) {
+		const RollbackStats& stats = session.getStats();
+		double gameSeconds = stats.frames * FRAME_TIME;
+		std::printf("%-10s %u frames (%u predicted), %u stalls, %u rollbacks, depth avg %.1f max %u\n", name, stats.frames, stats.predictedFrames, stats.stalls, stats.rollbacks, stats.rollbacks ? (double)stats.resimulatedFrames / stats.rollbacks : 0.0, stats.maxRollbackDepth);
+		std::printf("%-10s %u frames resimulated, %.0f per game second, %.0f per wall second; packets %u sent %u received %u rejected\n", "", stats.resimulatedFrames, stats.resimulatedFrames / gameSeconds, stats.resimulatedFrames / seconds, stats.packetsSent, stats.packetsReceived, stats.packetsRejected);
+	}
+
+	// Peers build their games wherever they like; two built over different leftover memory have to hash the same,
+	// including the ball slots the sketch's court never uses
+	bool freshGamesMatch() {
+		typedef BasicGame<ClassicCourtConfig> CourtGame;
+		uint32_t hash[2];
+		for (int i = 0; i < 2; ++i) {
+			void* memory = std::malloc(sizeof(CourtGame));
+			std::memset(memory, i ? 0xa5 : 0x5a, sizeof(CourtGame));
+			CourtGame* game = new (memory) CourtGame();
+			game->seed(1);
+			game->setup(courtSettings());
+			hash[i] = game->stateHash();
+			game->~CourtGame();
+			std::free(memory);
+		}
+		std::printf("fresh games over different memory %08x %08x\n", hash[0], hash[1]);
+		return hash[0] == hash[1];
+	}
+
+	bool selfTest() {
+		const unsigned int frames = 60 * PHYSICS_STEP_RATE;
+		if (!freshGamesMatch()) {
+			return false;
+		}
+
+		UdpTransport udp[2];
+		if (!udp[0].open(0) || !udp[1].open(0)) {
+			std::fprintf(stderr, "can't open UDP sockets on 127.0.0.1\n");
+			return false;
+		}
+		udp[0].connect(udp[1].port());
+		udp[1].connect(udp[0].port());
+
+		// 6 frames (25ms) each way, up to 4 more of jitter, and one packet in ten lost
+		LaggyTransport laggy0(&udp[0], 6, 4, 10, 1);
+		LaggyTransport laggy1(&udp[1], 6, 4, 10, 2);
+		LaggyTransport* laggy[2] = {&laggy0, &laggy1};
+
+		Game* game[2] = {makeGame(), makeGame()};
+		RollbackSession session0(game[0], laggy[0], 1 << 0, FRAME_TIME);
+		RollbackSession session1(game[1], laggy[1], 1 << 1, FRAME_TIME);
+		RollbackSession* session[2] = {&session0, &session1};
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		long clock = 0;
+		float speeds[2][MAX_NUM_PLAYERS];
+		while (session[0]->currentFrame() < frames || session[1]->currentFrame() < frames) {
+			++clock;
+			for (int side = 0; side < 2; ++side) {
+				laggy[side]->setTime(clock);
+				if (session[side]->currentFrame() < frames) {
+					if (session[side]->currentFrame() % (PHYSICS_STEP_RATE / 60) == 0) {
+						chooseSpeeds(*game[side], side, speeds[side]);
+					}
+					session[side]->advance(speeds[side]);
+				} else {
+					session[side]->poll();
+				}
+			}
+
+			// Packets between the two sockets take a moment even on loopback
+			if (clock % 64 == 0) {
+				std::this_thread::sleep_for(std::chrono::microseconds(50));
+			}
+		}
+
+		// Keep talking until each side has all of the other's input for every frame
+		long deadline = clock + 10 * PHYSICS_STEP_RATE;
+		while ((session[0]->confirmedFrames() < frames || session[1]->confirmedFrames() < frames) && clock < deadline) {
+			++clock;
+			for (int side = 0; side < 2; ++side) {
+				laggy[side]->setTime(clock);
+				session[side]->poll();
+			}
+			std::this_thread::sleep_for(std::chrono::microseconds(20));
+		}
+		double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		report("player 1", *session[0], seconds);
+		report("player 2", *session[1], seconds);
+
+		uint32_t hash0 = game[0]->stateHash();
+		uint32_t hash1 = game[1]->stateHash();
+		std::printf("confirmed %u/%u frames, final state %08x %08x, score %d-%d\n", session[0]->confirmedFrames(), session[1]->confirmedFrames(), hash0, hash1, game[0]->getStats().leftScore, game[0]->getStats().rightScore);
+
+		bool passed = session[0]->confirmedFrames() == frames && session[1]->confirmedFrames() == frames && hash0 == hash1 && session[0]->getStats().rollbacks > 0;
+		delete game[0];
+		delete game[1];
+		return passed;
+	}
+
+	int runSide(int player, int port, int peerPort, int seconds, int latencyMs) {
+		UdpTransport udp;
+		if (!udp.open(port)) {
+			std::fprintf(stderr, "can't listen on 127.0.0.1:%d\n", port);
+			return 1;
+		}
+		udp.connect(peerPort);
+		LaggyTransport laggy(&udp, latencyMs, latencyMs / 4, 0, player);
+
+		int side = player - 1;
+		Game* game = makeGame();
+		RollbackSession session(game, &laggy, 1 << side, FRAME_TIME);
+
+		const unsigned int frames = seconds * PHYSICS_STEP_RATE;
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		std::chrono::steady_clock::time_point next = start;
+		std::chrono::microseconds frameTime(1000000 / PHYSICS_STEP_RATE);
+		float speeds[MAX_NUM_PLAYERS];
+
+		std::printf("player %d on port %d, waiting for port %d\n", player, port, peerPort);
+		while (session.currentFrame() < frames) {
+			laggy.setTime(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
+			if (session.currentFrame() % (PHYSICS_STEP_RATE / 60) == 0) {
+				chooseSpeeds(*game, side, speeds);
+			}
+			session.advance(speeds);
+
+			next += frameTime;
+			std::this_thread::sleep_until(next);
+		}
+
+		// Settle up, then linger so the other side hears we have everything
+		std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+		while ((session.confirmedFrames() < frames || session.acknowledgedFrames() < frames) && std::chrono::steady_clock::now() < deadline) {
+			laggy.setTime(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
+			session.poll();
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+		for (int i = 0; i < 200; ++i) {
+			laggy.setTime(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
+			session.poll();
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+
+		double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		char name[16];
+		std::snprintf(name, sizeof(name), "player %d", player);
+		report(name, session, elapsed);
+		std::printf("confirmed %u frames, final state %08x, score %d-%d\n", session.confirmedFrames(), game->stateHash(), game->getStats().leftScore, game->getStats().rightScore);
+
+		delete game;
+		return session.confirmedFrames() == frames ? 0 : 1;
+	}
+}
+
+int main(int argc, char** argv) {
+	if (argc < 2) {
+		return selfTest() ? 0 : 1;
+	}
+	if (argc < 4) {
+		std::fprintf(stderr, "usage: %s [PLAYER PORT PEER_PORT [SECONDS] [LATENCY_MS]]\n", argv[0]);
+		return 1;
+	}
+
+	int player = std::atoi(argv[1]);
+	if (player != 1 && player != 2) {
+		std::fprintf(stderr, "player has to be 1 or 2\n");
+		return 1;
+	}
+	int seconds = argc > 4 ? std::atoi(argv[4]) : 30;
+	int latencyMs = argc > 5 ? std::atoi(argv[5]) : 40;
+	return runSide(player, std::atoi(argv[2]), std::atoi(argv[3]), seconds, latencyMs);
+}
@@ -0,0 +1,226 @@
+// Drives SceneMachine through timed transitions, frames longer than a whole scene and enter functions that change
+// scene, and checks it neither drifts, skips a scene nor loops forever.
+//
+//   scene_machine_check
+//
+// Frame times are random within what the sketch sees, and the expected transition times are worked out on a double
+// clock alongside, so float rounding in the machine shows up as drift.
+
+#include <cmath>
+#include <cstdio>
+
+#include "scenemachine.h"
+#include "prng.h"
+
+namespace {
+
+	SceneMachine* machine;
+
+	// What each scene's functions have seen, and the scene they ask for from enter or update; NO_SCENE asks for none
+	int entries[MAX_NUM_SCENES];
+	int updates[MAX_NUM_SCENES];
+	int changeOnEnter[MAX_NUM_SCENES];
+	int changeOnUpdate[MAX_NUM_SCENES];
+
+	// Scenes in the order they were entered
+	int entered[64];
+	int numEntered;
+
+	template <int N>
+	void enter() {
+		++entries[N];
+		if (numEntered < 64) {
+			entered[numEntered] = N;
+		}
+		++numEntered;
+		if (changeOnEnter[N] != NO_SCENE) {
+			machine->change(changeOnEnter[N]);
+		}
+	}
+
+	template <int N>
+	void update(float dt) {
+		++updates[N];
+		if (changeOnUpdate[N] != NO_SCENE) {
+			machine->change(changeOnUpdate[N]);
+		}
+	}
+
+	void reset(SceneMachine& _machine) {
+		machine = &_machine;
+		for (int i = 0; i < MAX_NUM_SCENES; ++i) {
+			entries[i] = 0;
+			updates[i] = 0;
+			changeOnEnter[i] = NO_SCENE;
+			changeOnUpdate[i] = NO_SCENE;
+		}
+		numEntered = 0;
+	}
+
+	void addScenes(SceneMachine& machine, const float* durations, const int* next) {
+		machine.addScene(0, enter<0>, update<0>, durations[0], next[0]);
+		machine.addScene(1, enter<1>, update<1>, durations[1], next[1]);
+		machine.addScene(2, enter<2>, update<2>, durations[2], next[2]);
+		machine.addScene(3, enter<3>, update<3>, durations[3], next[3]);
+		machine.addScene(4, enter<4>, update<4>, durations[4], next[4]);
+		machine.addScene(5, enter<5>, update<5>, durations[5], next[5]);
+		machine.addScene(6, enter<6>, update<6>, durations[6], next[6]);
+		machine.addScene(7, enter<7>, update<7>, durations[7], next[7]);
+	}
+
+	bool check(const char* name, bool passed) {
+		std::printf("  %-44s %s\n", name, passed ? "ok" : "FAILED");
+		return passed;
+	}
+
+	// A title and a serve that hand over to each other by time alone, for ten minutes of uneven frames
+	bool timedChain() {
+		const float durations[MAX_NUM_SCENES] = {0.5f, 0.25f};
+		const int next[MAX_NUM_SCENES] = {1, 0, NO_SCENE, NO_SCENE, NO_SCENE, NO_SCENE, NO_SCENE, NO_SCENE};
+		const double cycle = 0.75;
+
+		SceneMachine sceneMachine;
+		reset(sceneMachine);
+		addScenes(sceneMachine, durations, next);
+		sceneMachine.change(0);
+
+		Prng frames(1);
+		double clock = 0;
+		double maxLateness = 0;
+		float maxDt = 0;
+		int lastScene = NO_SCENE;
+		for (int frame = 0; frame < 36000; ++frame) {
+			// 10 to 24 ms, around the sketch's 60Hz
+			float dt = (10000 + frames.below(14001)) / 1000000.0f;
+			if (dt > maxDt) {
+				maxDt = dt;
+			}
+			sceneMachine.update(dt);
+			clock += dt;
+
+			// A transition lands in the first frame at or past its time, and the scene starts with what's past it
+			int scene = sceneMachine.currentScene();
+			if (scene != lastScene && lastScene != NO_SCENE) {
+				double due = std::floor(clock / cycle) * cycle + (scene == 1 ? 0.5 : 0);
+				if (due > clock) {
+					due -= cycle;
+				}
+				double lateness = clock - due;
+				if (lateness > maxLateness) {
+					maxLateness = lateness;
+				}
+			}
+			lastScene = scene;
+		}
+
+		double cycles = std::floor(clock / cycle);
+		double into = clock - cycles * cycle;
+		int expectedScene = into >= 0.5 ? 1 : 0;
+		double expectedTime = expectedScene ? into - 0.5 : into;
+		double drift = std::fabs(sceneMachine.timeInScene() - expectedTime);
+
+		std::printf("timed chain: %.3f s, %d title and %d serve entries, %.3f ms in scene %d, drifted %.3f ms, transitions up to %.3f ms late\n", clock, entries[0], entries[1], sceneMachine.timeInScene() * 1000, sceneMachine.currentScene(), drift * 1000, maxLateness * 1000);
+		bool passed = true;
+		passed = check("enters as often as the clock says", entries[0] == (int)cycles + 1 && entries[1] == (int)cycles + (expectedScene == 1 ? 1 : 0)) && passed;
+		passed = check("ends in the right scene", sceneMachine.currentScene() == expectedScene) && passed;
+		passed = check("carries leftover time without drifting", drift < 0.001) && passed;
+		passed = check("moves on within a frame", maxLateness < maxDt + 0.0001) && passed;
+		return passed;
+	}
+
+	// Frames of 0.35 s through scenes of 0.1 s, as after the sketch stalls: one scene a frame, none skipped, no time lost
+	bool longFrames() {
+		const float durations[MAX_NUM_SCENES] = {0, 0, 0, 0.1f, 0.1f, 0.1f};
+		const int next[MAX_NUM_SCENES] = {NO_SCENE, NO_SCENE, NO_SCENE, 4, 5, 3, NO_SCENE, NO_SCENE};
+
+		SceneMachine sceneMachine;
+		reset(sceneMachine);
+		addScenes(sceneMachine, durations, next);
+		sceneMachine.change(3);
+
+		bool inOrder = true;
+		bool oneAFrame = true;
+		bool conserved = true;
+		int updatesRun = 0;
+		float frameTime = 0.35f;
+		for (int i = 0; i < 10; ++i) {
+			int before = numEntered;
+			sceneMachine.update(frameTime);
+			++updatesRun;
+			oneAFrame = oneAFrame && numEntered - before == (i == 0 ? 2 : 1);
+		}
+
+		// Frames of nothing let it catch up, still one scene at a time
+		int catchUp = 0;
+		while (sceneMachine.timeInScene() >= 0.1f && catchUp < 64) {
+			int before = numEntered;
+			sceneMachine.update(0);
+			oneAFrame = oneAFrame && numEntered - before == 1;
+			++catchUp;
+		}
+
+		for (int i = 0; i < numEntered && i < 64; ++i) {
+			inOrder = inOrder && entered[i] == 3 + i % 3;
+		}
+		double spent = (numEntered - 1) * 0.1 + sceneMachine.timeInScene();
+		conserved = std::fabs(spent - updatesRun * frameTime) < 0.0001;
+
+		std::printf("long frames: %d frames of %.2f s and %d empty ones through %d scenes, %.3f s accounted for of %.3f s\n", updatesRun, frameTime, catchUp, numEntered, spent, updatesRun * frameTime);
+		bool passed = true;
+		passed = check("enters the chain in order", inOrder) && passed;
+		passed = check("moves on one scene a frame", oneAFrame) && passed;
+		passed = check("keeps every second of the frames", conserved) && passed;
+		passed = check("catches up once frames are short", catchUp > 0 && sceneMachine.timeInScene() < 0.1f) && passed;
+		passed = check("gives every scene an update", updates[3] > 0 && updates[4] > 0 && updates[5] > 0) && passed;
+		return passed;
+	}
+
+	// Enter functions that change scene: one that hands straight on, and two that hand to each other forever
+	bool changesOnEnter() {
+		const float durations[MAX_NUM_SCENES] = {0, 0, 0, 0, 0, 0, 0, 0.1f};
+		const int next[MAX_NUM_SCENES] = {NO_SCENE, NO_SCENE, NO_SCENE, NO_SCENE, NO_SCENE, NO_SCENE, NO_SCENE, 2};
+		bool passed = true;
+
+		SceneMachine sceneMachine;
+		reset(sceneMachine);
+		addScenes(sceneMachine, durations, next);
+
+		// A scene that decides on entering that it's not wanted runs none of its updates
+		changeOnEnter[0] = 1;
+		sceneMachine.change(0);
+		sceneMachine.update(0.01f);
+		std::printf("change on enter: scene %d, entered %d and %d times, updated %d and %d times\n", sceneMachine.currentScene(), entries[0], entries[1], updates[0], updates[1]);
+		passed = check("hands straight on", sceneMachine.currentScene() == 1 && entries[0] == 1 && entries[1] == 1) && passed;
+		passed = check("runs only the scene it ends up in", updates[0] == 0 && updates[1] == 1) && passed;
+
+		// A change from update wins over the timed transition in the same frame
+		reset(sceneMachine);
+		changeOnUpdate[7] = 0;
+		sceneMachine.change(7);
+		sceneMachine.update(0.2f);
+		passed = check("change() from update beats the timer", sceneMachine.currentScene() == 0 && entries[2] == 0) && passed;
+
+		// Two scenes that send each other back: update() has to return all the same, having given every scene a turn
+		// once for the change from before the frame and once for the one left from the last enter
+		reset(sceneMachine);
+		changeOnEnter[5] = 6;
+		changeOnEnter[6] = 5;
+		sceneMachine.change(5);
+		sceneMachine.update(0.01f);
+		int firstFrame = entries[5] + entries[6];
+		sceneMachine.update(0.01f);
+		std::printf("ping-pong: %d entries in the first frame, %d after a second, scene %d\n", firstFrame, entries[5] + entries[6], sceneMachine.currentScene());
+		passed = check("gives up after every scene has had a turn", firstFrame == 2 * MAX_NUM_SCENES) && passed;
+		passed = check("goes on giving up a frame at a time", entries[5] + entries[6] == 4 * MAX_NUM_SCENES) && passed;
+		return passed;
+	}
+}
+
+int main() {
+	bool passed = true;
+	passed = timedChain() && passed;
+	passed = longFrames() && passed;
+	passed = changesOnEnter() && passed;
+	std::printf("%s\n", passed ? "ok" : "FAILED");
+	return passed ? 0 : 1;
+}
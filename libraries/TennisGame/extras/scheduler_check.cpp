@@ -0,0 +1,164 @@
+// Runs the sketch's task layout through the Scheduler on a simulated clock and checks the rates, deadline misses
+// and statistics it reports.
+//
+//   scheduler_check
+//
+// Each task charges the clock a made-up runtime instead of taking real time, so runs are exact and repeatable.
+// The physics task advances a real Game between two computer players, so the scheduled dt values are what the
+// game sees on the Teensy.
+
+#include <cstdio>
+
+#include "game.h"
+#include "interceptcontroller.h"
+#include "scheduler.h"
+#include "court.h"
+
+namespace {
+
+	// Same rates as the sketch
+	const unsigned long INPUT_PERIOD = 1000000 / 500;
+	const unsigned long PHYSICS_PERIOD = 1000000 / PHYSICS_STEP_RATE;
+	const unsigned long RENDER_PERIOD = 1000000 / 60;
+
+	unsigned long simulatedTime;
+
+	unsigned long simulatedClock() {
+		return simulatedTime;
+	}
+
+	// Runtimes charged per run; the render task overruns every renderSlowEvery'th frame when that isn't 0
+	unsigned long inputCost;
+	unsigned long physicsCost;
+	unsigned long renderCost;
+	unsigned long renderSlowCost;
+	unsigned long renderSlowEvery;
+	unsigned long renderRuns;
+
+	Game* game;
+	InterceptController computer[2];
+	float physicsTime;
+
+	void input(float dt) {
+		for (int i = 0; i < 2; ++i) {
+			computer[i].update(dt);
+		}
+		simulatedTime += inputCost;
+	}
+
+	void physics(float dt) {
+		game->advance(dt);
+		if (game->winCondition()) {
+			game->resetPlayersAndBall();
+		}
+		physicsTime += dt;
+		simulatedTime += physicsCost;
+	}
+
+	void render(float dt) {
+		++renderRuns;
+		simulatedTime += renderSlowEvery && renderRuns % renderSlowEvery == 0 ? renderSlowCost : renderCost;
+	}
+
+	struct Scenario {
+		const char* name;
+		unsigned long start;
+		unsigned long seconds;
+		unsigned long inputCost;
+		unsigned long physicsCost;
+		unsigned long renderCost;
+		unsigned long renderSlowCost;
+		unsigned long renderSlowEvery;
+	};
+
+	const char* taskNames[] = {"input", "physics", "render"};
+
+	bool near(unsigned long value, unsigned long expected, unsigned long tolerance) {
+		return value + tolerance >= expected && value <= expected + tolerance;
+	}
+
+	bool runScenario(const Scenario& scenario) {
+		simulatedTime = scenario.start;
+		inputCost = scenario.inputCost;
+		physicsCost = scenario.physicsCost;
+		renderCost = scenario.renderCost;
+		renderSlowCost = scenario.renderSlowCost;
+		renderSlowEvery = scenario.renderSlowEvery;
+		renderRuns = 0;
+		physicsTime = 0;
+
+		game = new Game(56, 24, 1);
+		game->setup(courtSettings());
+		game->seed(1);
+		for (int i = 0; i < MAX_NUM_PLAYERS; ++i) {
+			if (i < 2) {
+				computer[i].bind(game, i);
+				computer[i].seed(i);
+				game->assignController(i, &computer[i]);
+			} else {
+				game->deactivatePlayer(i);
+			}
+		}
+
+		Scheduler scheduler(simulatedClock);
+		scheduler.addTask(input, INPUT_PERIOD);
+		scheduler.addTask(physics, PHYSICS_PERIOD);
+		scheduler.addTask(render, RENDER_PERIOD);
+
+		const unsigned long end = scenario.start + scenario.seconds * 1000000;
+		unsigned long idle = 0;
+		while ((long)(simulatedTime - end) < 0) {
+			if (!scheduler.runNext()) {
+				unsigned long wait = scheduler.idleTime();
+				idle += wait;
+				simulatedTime += wait;
+			}
+		}
+
+		std::printf("%s: %lu s, %.1f%% idle, %.3f s of game time\n", scenario.name, scenario.seconds, 100.0 * idle / (scenario.seconds * 1000000), physicsTime);
+		std::printf("  %-8s %8s %7s %8s %10s %10s %12s\n", "task", "runs", "misses", "skipped", "avg us", "max us", "max late us");
+		for (int i = 0; i < scheduler.numberOfTasks(); ++i) {
+			const TaskStats& stats = scheduler.getStats(i);
+			std::printf("  %-8s %8lu %7lu %8lu %10.1f %10lu %12lu\n", taskNames[i], stats.runs, stats.misses, stats.skipped, stats.runs ? (double)stats.totalRuntime / stats.runs : 0.0, stats.maxRuntime, stats.maxLateness);
+		}
+
+		const TaskStats& inputStats = scheduler.getStats(0);
+		const TaskStats& physicsStats = scheduler.getStats(1);
+		const TaskStats& renderStats = scheduler.getStats(2);
+		const unsigned long slowFrames = scenario.renderSlowEvery ? renderStats.runs / scenario.renderSlowEvery : 0;
+		bool passed;
+		if (!slowFrames) {
+			// Nothing runs long enough to hold another task past its deadline: every task keeps its rate and none misses
+			passed = near(inputStats.runs, scenario.seconds * 1000000 / INPUT_PERIOD, 1)
+				&& near(physicsStats.runs, scenario.seconds * 1000000 / PHYSICS_PERIOD, 1)
+				&& near(renderStats.runs, scenario.seconds * 1000000 / RENDER_PERIOD, 1)
+				&& !inputStats.misses && !physicsStats.misses && !renderStats.misses
+				&& !inputStats.skipped && !physicsStats.skipped && !renderStats.skipped;
+		} else {
+			// Every slow frame is a miss of its own and holds up the faster tasks past theirs, which drop what they can't make up;
+			// game time still keeps up with the clock because the physics task's dt covers whatever it skipped
+			passed = renderStats.misses >= slowFrames && physicsStats.misses > 0 && physicsStats.skipped > 0
+				&& physicsStats.maxLateness >= scenario.renderSlowCost - PHYSICS_PERIOD
+				&& physicsTime > scenario.seconds - 0.05f && physicsTime < scenario.seconds + 0.05f;
+		}
+		passed = passed && game->getStats().tunnelingEvents == 0;
+		std::printf("  %s\n", passed ? "ok" : "FAILED");
+
+		delete game;
+		return passed;
+	}
+}
+
+int main() {
+	const Scenario scenarios[] = {
+		{"light load", 0, 10, 40, 600, 1000, 0, 0},
+		{"clock wrapping", (unsigned long)-3000000, 10, 40, 600, 1000, 0, 0},
+		{"render overrun", 0, 10, 40, 600, 1000, 25000, 20}
+	};
+
+	bool passed = true;
+	for (size_t i = 0; i < sizeof(scenarios) / sizeof(scenarios[0]); ++i) {
+		passed = runScenario(scenarios[i]) && passed;
+	}
+	return passed ? 0 : 1;
+}
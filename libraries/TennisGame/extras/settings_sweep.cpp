@@ -0,0 +1,280 @@
+// Plays thousands of computer-vs-computer matches for each of a grid or random sample of GameSettings,
+// spread over every core, and writes rally length and win balance statistics for each setting as CSV.
+//
+//   settings_sweep [-i RANGE] [-t RANGE] [-v RANGE] [-u RANGE] [-w RANGE] [-h RANGE]
+//                  [-r SAMPLES] [-m MATCHES] [-p POINTS] [-s SEED] [-j THREADS] [-o FILE]
+//
+// RANGE is LOW:HIGH:STEPS, LOW:HIGH (three steps) or a single value, for
+//   -i ballVelocityIncrease           -t ballVelocityIncreaseInterval    -v maxBallVelocity
+//   -u ballInitialVelocity, per axis  -w playerMaxMoveSpeed              -h playerHeight
+// Anything not given stays as the sketch has it. The grid covers every combination of the steps;
+// -r instead picks SAMPLES settings uniformly from the ranges. Every setting plays the same seeds,
+// SEED to SEED + MATCHES - 1, so differences between settings aren't down to luck of the draw.
+
+#include <unistd.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "game.h"
+#include "court.h"
+#include "match.h"
+#include "work_stealing_pool.h"
+
+namespace {
+
+	// Matches one task plays; enough that taking a task costs nothing next to playing it
+	const int MATCHES_PER_TASK = 4;
+
+	// Rallies at least this long count as long in the CSV
+	const unsigned int LONG_RALLY = 8;
+
+	enum Parameter {
+		BALL_VELOCITY_INCREASE,
+		BALL_VELOCITY_INCREASE_INTERVAL,
+		MAX_BALL_VELOCITY,
+		SERVE_VELOCITY,
+		PADDLE_SPEED,
+		PADDLE_HEIGHT,
+		NUM_PARAMETERS
+	};
+
+	struct ParameterRange {
+		const char* name;
+		char flag;
+		float low;
+		float high;
+		int steps;
+	};
+
+	ParameterRange ranges[NUM_PARAMETERS] = {
+		{"ball_velocity_increase", 'i', 0, 0, 1},
+		{"ball_velocity_increase_interval", 't', 0, 0, 1},
+		{"max_ball_velocity", 'v', 0, 0, 1},
+		{"serve_velocity", 'u', 0, 0, 1},
+		{"paddle_speed", 'w', 0, 0, 1},
+		{"paddle_height", 'h', 0, 0, 1}
+	};
+
+	struct Setting {
+		float values[NUM_PARAMETERS];
+	};
+
+	void readDefaults(const GameSettings& settings) {
+		float defaults[NUM_PARAMETERS] = {
+			physics::toFloat(settings.ballVelocityIncrease),
+			physics::toFloat(settings.ballVelocityIncreaseInterval),
+			physics::toFloat(settings.maxBallVelocity),
+			physics::toFloat(settings.ballInitialVelocity.x),
+			physics::toFloat(settings.playerMaxMoveSpeed[0]),
+			physics::toFloat(settings.playerHeight[0])
+		};
+		for (int i = 0; i < NUM_PARAMETERS; ++i) {
+			ranges[i].low = ranges[i].high = defaults[i];
+		}
+	}
+
+	GameSettings apply(GameSettings settings, const Setting& setting) {
+		settings.ballVelocityIncrease = setting.values[BALL_VELOCITY_INCREASE];
+		settings.ballVelocityIncreaseInterval = setting.values[BALL_VELOCITY_INCREASE_INTERVAL];
+		settings.maxBallVelocity = setting.values[MAX_BALL_VELOCITY];
+		settings.ballInitialVelocity = physics::vector2d(setting.values[SERVE_VELOCITY], setting.values[SERVE_VELOCITY]);
+		for (int i = 0; i < MAX_NUM_PLAYERS; ++i) {
+			settings.playerMaxMoveSpeed[i] = setting.values[PADDLE_SPEED];
+			settings.playerHeight[i] = setting.values[PADDLE_HEIGHT];
+		}
+		return settings;
+	}
+
+	// LOW:HIGH:STEPS, LOW:HIGH or VALUE
+	bool parseRange(const char* text, ParameterRange& range) {
+		char* end;
+		range.low = range.high = std::strtof(text, &end);
+		range.steps = 1;
+		if (end == text) {
+			return false;
+		}
+		if (*end == ':') {
+			text = end + 1;
+			range.high = std::strtof(text, &end);
+			range.steps = 3;
+			if (end == text) {
+				return false;
+			}
+			if (*end == ':') {
+				text = end + 1;
+				range.steps = std::strtol(text, &end, 10);
+				if (end == text || range.steps < 1) {
+					return false;
+				}
+			}
+		}
+		return *end == 0;
+	}
+
+	float step(const ParameterRange& range, int i) {
+		return range.steps > 1 ? range.low + (range.high - range.low) * i / (range.steps - 1) : range.low;
+	}
+
+	// Every combination of steps, the first parameter changing slowest
+	std::vector<Setting> makeGrid() {
+		std::vector<Setting> settings(1);
+		for (int p = 0; p < NUM_PARAMETERS; ++p) {
+			std::vector<Setting> grown;
+			for (size_t s = 0; s < settings.size(); ++s) {
+				for (int i = 0; i < ranges[p].steps; ++i) {
+					Setting setting = settings[s];
+					setting.values[p] = step(ranges[p], i);
+					grown.push_back(setting);
+				}
+			}
+			settings.swap(grown);
+		}
+		return settings;
+	}
+
+	std::vector<Setting> makeSamples(int count, uint32_t seed) {
+		Prng random(seed);
+		std::vector<Setting> settings(count);
+		for (int s = 0; s < count; ++s) {
+			for (int p = 0; p < NUM_PARAMETERS; ++p) {
+				settings[s].values[p] = ranges[p].low + (ranges[p].high - ranges[p].low) * (random.next() >> 8) / float(1 << 24);
+			}
+		}
+		return settings;
+	}
+
+	void writeHeader(FILE* csv) {
+		std::fprintf(csv, "setting");
+		for (int p = 0; p < NUM_PARAMETERS; ++p) {
+			std::fprintf(csv, ",%s", ranges[p].name);
+		}
+		std::fprintf(csv, ",matches,points,rally_mean,rally_stddev,rally_max,long_rally_share,left_win_share,win_balance,unfinished,seconds_per_point,tunneling_events\n");
+	}
+
+	// win_balance is 1 when both sides win equally often and 0 when one side wins everything
+	void writeRow(FILE* csv, int index, const Setting& setting, int matches, const MatchResults& results) {
+		double points = results.points ? results.points : 1;
+		double mean = results.rallyHits / points;
+		double variance = results.rallyHitsSquared / points - mean * mean;
+		unsigned int longRallies = 0;
+		for (int i = rallyBucket(LONG_RALLY); i < RALLY_BUCKETS; ++i) {
+			longRallies += results.rallies[i];
+		}
+		unsigned int decided = results.leftWins + results.rightWins;
+		double leftShare = decided ? (double)results.leftWins / decided : 0.5;
+
+		std::fprintf(csv, "%d", index);
+		for (int p = 0; p < NUM_PARAMETERS; ++p) {
+			std::fprintf(csv, ",%g", setting.values[p]);
+		}
+		std::fprintf(csv, ",%d,%u,%.3f,%.3f,%u,%.4f,%.4f,%.4f,%u,%.3f,%u\n", matches, results.points, mean, std::sqrt(variance > 0 ? variance : 0), results.longestRally, longRallies / points, leftShare, 1 - std::fabs(2 * leftShare - 1), results.unfinished, results.ticks / (double)PHYSICS_STEP_RATE / points, results.tunnelingEvents);
+	}
+
+	void usage(const char* name) {
+		std::fprintf(stderr, "usage: %s [-i|-t|-v|-u|-w|-h LOW[:HIGH[:STEPS]]]... [-r SAMPLES] [-m MATCHES] [-p POINTS] [-s SEED] [-j THREADS] [-o FILE]\n", name);
+	}
+}
+
+int main(int argc, char** argv) {
+	const GameSettings court = courtSettings();
+	readDefaults(court);
+
+	MatchOptions match;
+	match.points = 11;
+	match.maxSeconds = 600;
+	match.players = 2;
+	match.balls = 1;
+	match.controllers = CONTROLLERS_CHASE;
+
+	int samples = 0;
+	int matches = 1000;
+	uint32_t seed = 1;
+	int threads = std::thread::hardware_concurrency();
+	const char* output = 0;
+
+	int option;
+	while ((option = getopt(argc, argv, "i:t:v:u:w:h:r:m:p:s:j:o:")) != -1) {
+		bool parsed = false;
+		for (int p = 0; p < NUM_PARAMETERS; ++p) {
+			if (option == ranges[p].flag) {
+				if (!parseRange(optarg, ranges[p])) {
+					usage(argv[0]);
+					return 1;
+				}
+				parsed = true;
+			}
+		}
+		if (parsed) {
+			continue;
+		}
+
+		switch (option) {
+			case 'r': samples = std::atoi(optarg); break;
+			case 'm': matches = std::atoi(optarg); break;
+			case 'p': match.points = std::atoi(optarg); break;
+			case 's': seed = std::strtoul(optarg, 0, 0); break;
+			case 'j': threads = std::atoi(optarg); break;
+			case 'o': output = optarg; break;
+			default:
+				usage(argv[0]);
+				return 1;
+		}
+	}
+	if (optind != argc || matches < 1 || match.points < 1 || samples < 0) {
+		usage(argv[0]);
+		return 1;
+	}
+
+	std::vector<Setting> settings = samples ? makeSamples(samples, seed) : makeGrid();
+
+	FILE* csv = output ? std::fopen(output, "w") : stdout;
+	if (!csv) {
+		std::fprintf(stderr, "can't write %s\n", output);
+		return 1;
+	}
+
+	// Each setting's matches are split into tasks; results land in their own slots and are added up in order afterwards
+	const int tasksPerSetting = (matches + MATCHES_PER_TASK - 1) / MATCHES_PER_TASK;
+	const int tasks = settings.size() * tasksPerSetting;
+	std::vector<MatchResults> results(tasks);
+
+	WorkStealingPool pool(threads);
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	pool.run(tasks, [&](int task) {
+		const int s = task / tasksPerSetting;
+		const int first = task % tasksPerSetting * MATCHES_PER_TASK;
+		const int last = first + MATCHES_PER_TASK < matches ? first + MATCHES_PER_TASK : matches;
+		const GameSettings gameSettings = apply(court, settings[s]);
+
+		MatchResults& total = results[task];
+		std::memset(&total, 0, sizeof(total));
+		for (int m = first; m < last; ++m) {
+			addMatchResults(total, playMatch(gameSettings, match, seed + m));
+		}
+	});
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	writeHeader(csv);
+	unsigned long ticks = 0;
+	for (size_t s = 0; s < settings.size(); ++s) {
+		MatchResults total;
+		std::memset(&total, 0, sizeof(total));
+		for (int t = 0; t < tasksPerSetting; ++t) {
+			addMatchResults(total, results[s * tasksPerSetting + t]);
+		}
+		writeRow(csv, s, settings[s], matches, total);
+		ticks += total.ticks;
+	}
+	if (output) {
+		std::fclose(csv);
+	}
+
+	std::fprintf(stderr, "%zu settings x %d matches in %.2f s on %d threads: %.0f matches/s, %.2f M ticks/s, %d tasks stolen\n", settings.size(), matches, seconds, pool.size(), settings.size() * matches / seconds, ticks / seconds / 1e6, pool.stolenTasks());
+	return 0;
+}
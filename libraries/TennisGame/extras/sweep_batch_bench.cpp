@@ -0,0 +1,208 @@
+// Checks sweepBatch against a loop of movingBoxCollidesWithStatic<STATIC_BOX> calls over the same
+// targets, and times both.
+//
+// Each case is a ball-sized box moving among TARGETS random still boxes, with a random subset of
+// them selected by the mask. Results agree when both miss, or both hit the same target with times
+// within TIME_TOLERANCE. Where two targets are hit at almost the same time either may be reported,
+// so a different index only counts as a mismatch when the times differ too.
+//
+// The timing also runs once with the only reachable target first and once with it last, to show
+// the batch costs the same wherever the hit is.
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "broadphase.h"
+#include "collision2d.h"
+#include "sweepbatch.h"
+
+using physics::fixed;
+
+#define TARGETS 24
+
+namespace {
+
+	const float TIME_TOLERANCE = 0.01f;
+
+	template <typename T>
+	struct Case {
+		physics::BasicMovingBox<T> box;
+		physics::BasicSweepTargets<T, TARGETS> targets;
+		uint32_t mask;
+		T dt;
+	};
+
+	uint32_t rngState = 0x9E3779B9u;
+
+	uint32_t next() {
+		rngState ^= rngState << 13;
+		rngState ^= rngState >> 17;
+		rngState ^= rngState << 5;
+		return rngState;
+	}
+
+	float uniform(float low, float high) {
+		return low + (high - low) * (next() & 0xFFFFFF) / float(0xFFFFFF);
+	}
+
+	template <typename T>
+	physics::BasicBounds<T> randomBox(physics::basic_vector2d<T> around, float spread) {
+		physics::BasicMovingBox<T> box;
+		box.position = around + physics::basic_vector2d<T>(uniform(-spread, spread), uniform(-spread, spread));
+		box.extents = physics::basic_vector2d<T>(uniform(0.25f, 2), uniform(0.25f, 2));
+		return physics::boxBounds(box);
+	}
+
+	template <typename T>
+	std::vector<Case<T> > makeCases(int count) {
+		rngState = 0x9E3779B9u;
+
+		std::vector<Case<T> > cases(count);
+		for (int i = 0; i < count; ++i) {
+			Case<T>& c = cases[i];
+			c.box.position = physics::basic_vector2d<T>(uniform(0, 56), uniform(0, 24));
+			c.box.extents = physics::basic_vector2d<T>(1, 1);
+			c.box.velocity = physics::basic_vector2d<T>(uniform(-140, 140), uniform(-140, 140));
+			c.dt = 1.0f / 60.0f;
+			for (int j = 0; j < TARGETS; ++j) {
+				c.targets.add(randomBox(c.box.position, 5));
+			}
+			c.mask = next() & ((1u << TARGETS) - 1);
+		}
+		return cases;
+	}
+
+	// A box far from everything, then one reachable target at the given index
+	template <typename T>
+	std::vector<Case<T> > makeSingleHitCases(int count, int hitIndex) {
+		rngState = 0x2545F491u;
+
+		std::vector<Case<T> > cases(count);
+		for (int i = 0; i < count; ++i) {
+			Case<T>& c = cases[i];
+			c.box.position = physics::basic_vector2d<T>(uniform(10, 40), uniform(5, 20));
+			c.box.extents = physics::basic_vector2d<T>(1, 1);
+			c.box.velocity = physics::basic_vector2d<T>(60, 0);
+			c.dt = 1.0f / 60.0f;
+			for (int j = 0; j < TARGETS; ++j) {
+				physics::basic_vector2d<T> offset(j == hitIndex ? 2.5f : -30.0f, 0);
+				c.targets.add(randomBox(c.box.position + offset, 0.25f));
+			}
+			c.mask = (1u << TARGETS) - 1;
+		}
+		return cases;
+	}
+
+	template <typename T>
+	physics::BasicBounds<T> targetBounds(const Case<T>& c, int i) {
+		physics::BasicBounds<T> bounds;
+		bounds.min = physics::basic_vector2d<T>(c.targets.minX[i], c.targets.minY[i]);
+		bounds.max = physics::basic_vector2d<T>(c.targets.maxX[i], c.targets.maxY[i]);
+		return bounds;
+	}
+
+	template <typename T>
+	int loop(const Case<T>& c, T& time) {
+		physics::basic_vector2d<T> position;
+		T candidate;
+		int hit = -1;
+		for (int i = 0; i < c.targets.count; ++i) {
+			if ((c.mask & (1u << i)) && physics::movingBoxCollidesWithStatic<physics::STATIC_BOX>(c.dt, c.box, targetBounds(c, i), position, candidate) && (hit < 0 || candidate < time)) {
+				hit = i;
+				time = candidate;
+			}
+		}
+		return hit;
+	}
+
+	template <typename T>
+	int batch(const Case<T>& c, T& time) {
+		return physics::sweepBatch(c.dt, c.box, c.targets, c.mask, time);
+	}
+
+	template <typename T>
+	bool compare(const char* name, const std::vector<Case<T> >& cases) {
+		int hits = 0;
+		int ties = 0;
+		int mismatches = 0;
+		for (size_t i = 0; i < cases.size(); ++i) {
+			T loopTime = T(0);
+			T batchTime = T(0);
+			int loopHit = loop(cases[i], loopTime);
+			int batchHit = batch(cases[i], batchTime);
+
+			bool timesAgree = std::fabs(physics::toFloat(loopTime) - physics::toFloat(batchTime)) <= TIME_TOLERANCE;
+			if ((loopHit < 0) != (batchHit < 0)) {
+				++mismatches;
+			} else if (loopHit >= 0) {
+				++hits;
+				if (!timesAgree) {
+					++mismatches;
+				} else if (loopHit != batchHit) {
+					++ties;
+				}
+			}
+		}
+		std::printf("%-24s %zu cases, %d hits, %d ties, %d mismatches\n", name, cases.size(), hits, ties, mismatches);
+		return mismatches == 0;
+	}
+
+	template <typename T>
+	void benchmark(const char* name, const std::vector<Case<T> >& cases, int rounds) {
+		volatile int sink = 0;
+		T time;
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (int round = 0; round < rounds; ++round) {
+			for (size_t i = 0; i < cases.size(); ++i) {
+				sink += loop(cases[i], time);
+			}
+		}
+		std::chrono::duration<double, std::nano> loopTime = std::chrono::steady_clock::now() - start;
+
+		start = std::chrono::steady_clock::now();
+		for (int round = 0; round < rounds; ++round) {
+			for (size_t i = 0; i < cases.size(); ++i) {
+				sink += batch(cases[i], time);
+			}
+		}
+		std::chrono::duration<double, std::nano> batchTime = std::chrono::steady_clock::now() - start;
+
+		double sweeps = double(rounds) * cases.size();
+		std::printf("%-24s loop %7.2f ns/sweep, batch %7.2f ns/sweep\n", name, loopTime.count() / sweeps, batchTime.count() / sweeps);
+	}
+
+	template <typename T>
+	bool run(const char* scalarName, int count, int rounds) {
+		char name[64];
+
+		std::vector<Case<T> > random = makeCases<T>(count);
+		std::snprintf(name, sizeof(name), "%s random", scalarName);
+		bool passed = compare(name, random);
+		benchmark(name, random, rounds);
+
+		std::vector<Case<T> > first = makeSingleHitCases<T>(count, 0);
+		std::snprintf(name, sizeof(name), "%s hit first", scalarName);
+		passed = compare(name, first) && passed;
+		benchmark(name, first, rounds);
+
+		std::vector<Case<T> > last = makeSingleHitCases<T>(count, TARGETS - 1);
+		std::snprintf(name, sizeof(name), "%s hit last", scalarName);
+		passed = compare(name, last) && passed;
+		benchmark(name, last, rounds);
+
+		return passed;
+	}
+}
+
+int main(int argc, char** argv) {
+	int count = argc > 1 ? std::atoi(argv[1]) : 20000;
+
+	bool passed = run<float>("float", count, 10);
+	passed = run<fixed>("fixed", count, 10) && passed;
+
+	return passed ? 0 : 1;
+}
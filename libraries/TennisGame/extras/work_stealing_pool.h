@@ -0,0 +1,90 @@
+// Runs a numbered batch of tasks over a fixed number of threads
+//
+// Each thread is dealt its own contiguous block of task numbers and works through it from the back.
+// A thread whose block runs dry steals from the front of another's, so a few slow tasks don't leave
+// the other threads idle, and threads only touch each other's blocks near the end of a batch.
+
+#ifndef WORK_STEALING_POOL_H
+#define WORK_STEALING_POOL_H
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class WorkStealingPool {
+public:
+	explicit WorkStealingPool(int _threads) : threads(_threads < 1 ? 1 : _threads), stolen(0) {}
+
+	int size() const {
+		return threads;
+	}
+
+	// Calls task(i) once for every i below count, from any of the threads, and returns when all are done
+	template <typename Task>
+	void run(int count, Task task) {
+		std::vector<Block> blocks(threads);
+		for (int t = 0; t < threads; ++t) {
+			blocks[t].begin = (long)count * t / threads;
+			blocks[t].end = (long)count * (t + 1) / threads;
+		}
+		stolen = 0;
+
+		std::vector<std::thread> workers;
+		for (int t = 1; t < threads; ++t) {
+			workers.push_back(std::thread(&WorkStealingPool::work<Task>, this, t, &blocks, &task));
+		}
+		work(0, &blocks, &task);
+		for (size_t i = 0; i < workers.size(); ++i) {
+			workers[i].join();
+		}
+	}
+
+	// Tasks in the last run that were taken from another thread's block
+	int stolenTasks() const {
+		return stolen;
+	}
+
+private:
+	struct Block {
+		std::mutex lock;
+		int begin;
+		int end;
+	};
+
+	template <typename Task>
+	void work(int self, std::vector<Block>* blocks, Task* task) {
+		int i;
+		while (takeOwn((*blocks)[self], i) || steal(self, *blocks, i)) {
+			(*task)(i);
+		}
+	}
+
+	static bool takeOwn(Block& block, int& i) {
+		std::lock_guard<std::mutex> guard(block.lock);
+		if (block.begin >= block.end) {
+			return false;
+		}
+		i = --block.end;
+		return true;
+	}
+
+	// Tasks are never added during a run, so once every block is empty the thread is done
+	bool steal(int self, std::vector<Block>& blocks, int& i) {
+		for (int offset = 1; offset < threads; ++offset) {
+			Block& victim = blocks[(self + offset) % threads];
+			std::lock_guard<std::mutex> guard(victim.lock);
+			if (victim.begin < victim.end) {
+				i = victim.begin++;
+				++stolen;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	int threads;
+	std::atomic<int> stolen;
+};
+
+#endif
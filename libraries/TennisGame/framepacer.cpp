@@ -0,0 +1,121 @@
+#include "framepacer.h"
+#include <math.h>
+#include <string.h>
+
+FramePacer::FramePacer(unsigned int _rate) : next(0), lastStart(0), started(false), align(false), displayPending(false) {
+	setRate(_rate);
+	lastInterval = period;
+	resetStats();
+}
+
+void FramePacer::setRate(unsigned int _rate) {
+	// The next frame keeps its slot; the ones after it are spaced by the new period
+	rate = _rate ? _rate : 1;
+	period = 1000000 / rate;
+	remainder = 1000000 % rate;
+	carried = 0;
+}
+
+void FramePacer::setAlignment(bool _align) {
+	align = _align;
+	displayPending = false;
+}
+
+void FramePacer::start(unsigned long now) {
+	next = now;
+	carried = 0;
+	advanceSlot();
+	lastStart = now;
+	lastInterval = period;
+	started = false;
+	displayPending = false;
+	resetStats();
+}
+
+bool FramePacer::frameDue(unsigned long now) {
+	if ((long)(now - next) < 0 || (align && displayPending)) {
+		return false;
+	}
+
+	// How far this frame is off its own slot
+	unsigned long late = now - next;
+	lastInterval = now - lastStart;
+	lastStart = now;
+	advanceSlot();
+
+	// Rather than run frames back to back to catch up, skip to the next slot still ahead
+	while ((long)(now - next) >= 0) {
+		advanceSlot();
+		++stats.dropped;
+	}
+	displayPending = align;
+
+	// The first frame has nothing before it to be measured against
+	if (!started) {
+		started = true;
+		return true;
+	}
+	++stats.frames;
+	stats.totalInterval += lastInterval;
+	stats.totalSquaredJitter += (unsigned long long)late * late;
+	if (lastInterval < stats.minInterval) {
+		stats.minInterval = lastInterval;
+	}
+	if (lastInterval > stats.maxInterval) {
+		stats.maxInterval = lastInterval;
+	}
+	if (late > stats.maxJitter) {
+		stats.maxJitter = late;
+	}
+	return true;
+}
+
+void FramePacer::displayFinished(unsigned long at) {
+	if (!displayPending) {
+		return;
+	}
+	displayPending = false;
+
+	// A display that took longer than the frame slot moves the frames after it to start when it's free again
+	unsigned long ready = at + FRAME_DISPLAY_GUARD;
+	if ((long)(ready - next) > 0) {
+		next = ready;
+		++stats.aligned;
+	}
+}
+
+// A period is 1000000 / rate microseconds and a bit; the bits are added up and paid out a microsecond at a time
+void FramePacer::advanceSlot() {
+	next += period;
+	carried += remainder;
+	if (carried >= rate) {
+		carried -= rate;
+		++next;
+	}
+}
+
+float FramePacer::frameTime() const {
+	return lastInterval / 1000000.0f;
+}
+
+unsigned long FramePacer::untilNextFrame(unsigned long now) const {
+	long until = (long)(next - now);
+	return until > 0 ? until : 0;
+}
+
+const FrameStats& FramePacer::getStats() const {
+	return stats;
+}
+
+void FramePacer::resetStats() {
+	memset(&stats, 0, sizeof(stats));
+	stats.minInterval = (unsigned long)-1;
+}
+
+float FramePacer::meanInterval() const {
+	return stats.frames ? (float)stats.totalInterval / stats.frames : 0;
+}
+
+float FramePacer::jitter() const {
+	return stats.frames ? sqrtf((float)stats.totalSquaredJitter / stats.frames) : 0;
+}
\ No newline at end of file
@@ -0,0 +1,74 @@
+#ifndef FRAMEPACER_H
+#define FRAMEPACER_H
+
+// Microseconds a frame waits after the display finishes sending, for the WS2811 reset
+#define FRAME_DISPLAY_GUARD 50
+
+struct FrameStats {
+	unsigned long frames;
+
+	// Frames dropped because the last one ran a whole period or more late, and frames held back for the display
+	unsigned long dropped;
+	unsigned long aligned;
+
+	// Microseconds between frame starts, and how late each started for its slot
+	unsigned long minInterval;
+	unsigned long maxInterval;
+	unsigned long long totalInterval;
+	unsigned long long totalSquaredJitter;
+	unsigned long maxJitter;
+};
+
+// Says when to start each frame, in microseconds from a micros()-like clock.
+// Frame times are kept as a running deadline that goes up by one period a frame, with the fraction of a microsecond
+// a period doesn't divide into carried from frame to frame, so rounding never adds up to drift; a frame that starts late
+// doesn't pull the next one any earlier than its own slot.
+// With alignment on, a frame is also held back until the display has finished sending the last one,
+// and the frames after it keep to that new phase.
+class FramePacer {
+public:
+	FramePacer(unsigned int _rate);
+
+	// Frames per second
+	void setRate(unsigned int _rate);
+	void setAlignment(bool _align);
+
+	// Starts the next frame a period from now, and the stats over
+	void start(unsigned long now);
+
+	// Whether a frame should start now; when it says so it counts the frame as started
+	bool frameDue(unsigned long now);
+
+	// With alignment on, call whenever the display isn't busy, with when it finished; a frame is due no sooner
+	void displayFinished(unsigned long at);
+
+	// Seconds between the last two frame starts
+	float frameTime() const;
+
+	// Microseconds until the next frame is due, 0 once it is
+	unsigned long untilNextFrame(unsigned long now) const;
+
+	const FrameStats& getStats() const;
+	void resetStats();
+
+	// Mean microseconds between frame starts, and the root mean square of how late frames started for their slots
+	float meanInterval() const;
+	float jitter() const;
+
+private:
+	void advanceSlot();
+
+	unsigned int rate;
+	unsigned long period;
+	unsigned int remainder;
+	unsigned int carried;
+	unsigned long next;
+	unsigned long lastStart;
+	unsigned long lastInterval;
+	bool started;
+	bool align;
+	bool displayPending;
+	FrameStats stats;
+};
+
+#endif
\ No newline at end of file
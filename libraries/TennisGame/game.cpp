@@ -1,431 +1,1261 @@
-#include "game.h"
-#include "collision2d.h"
-
-Game::Game(int _screenWidth, int _screenHeight, int _physicsToPixelRatio) {
-	utility.screenWidth = _screenWidth;
-	utility.screenHeight = _screenHeight;
-	utility.physicsToPixelRatio = _physicsToPixelRatio;
-	
-	for (int i = 0; i < MAX_NUM_PLAYERS; ++i) {
-		controller[i] = 0;
-	}
-	
-	ballCollidesWithWall = 0;
-	ballCollidesWithPaddle = 0;
-}
-
-void Game::setup(GameSettings _settings) {
-	// Settings
-	settings = _settings;
-
-	for (int i = 0; i < NUM_HORIZONTAL_WALLS; ++i) {
-		horizontalWalls[i].setup(settings.horizontalWallPoints[i], settings.horizontalWallLengths[i]);
-	}
-
-	for (int i = 0; i < NUM_VERTICAL_WALLS; ++i) {
-		verticalWalls[i].setup(settings.verticalWallPoints[i], settings.verticalWallLengths[i]);
-	}
-	
-	resetPlayersAndBall();
-	resetScore();
-}
-
-void Game::resetPlayersAndBall() {
-	startTimer = 0;
-	pauseBall = true;
-	ballVelocityIncreaseTimer = 0;
-	ball.setup(settings.ballInitialPoint, settings.ballDiameter, settings.ballInitialVelocity);
-
-	// Randomize ball take-off
-	if (stats.tick && stats.tick % 2 == 0) {
-		ball.reverseVelocityX();
-	}
-	if (stats.tick && stats.tick % 3 == 0) {
-		ball.reverseVelocityY();
-	}
-
-	for (int i = 0; i < MAX_NUM_PLAYERS; ++i) {
-		paddles[i].setup(settings.playerInitialPoint[i], settings.playerLength[i], settings.playerHeight[i]);
-		player[i].setup(&paddles[i], settings.playerMaxMoveSpeed[i]);
-	}
-}
-
-void Game::resetScore() {
-	stats.leftScore = 0;
-	stats.rightScore = 0;
-	stats.tick = 0;
-}
-
-void Game::assignController(int playerNum, PlayerController* _controller) {
-	controller[playerNum] = _controller;
-}
-
-bool Game::winCondition() {
-	if (ball.getPosition().x + ball.getRadius() + 1 < 0) {
-		++stats.rightScore;
-		return true;
-	} else if (ball.getPosition().x - ball.getRadius() - 1 > utility.screenToPhysics(utility.screenWidth - 1)) {
-		++stats.leftScore;
-		return true;
-	}
-	return false;
-}
-
-void Game::tick(float dt) {
-	++stats.tick;
-	
-	if (startTimer >= 0) {
-		startTimer += dt;
-		if (startTimer >= settings.startDelay) {
-			startTimer = -1;
-			pauseBall = false;
-		}
-	}
-	
-	if (!pauseBall) {
-		ballVelocityIncreaseTimer += dt;
-		if (ballVelocityIncreaseTimer >= settings.ballVelocityIncreaseInterval) {
-			ballVelocityIncreaseTimer = 0;
-			ball.increaseVelocity(settings.ballVelocityIncrease);
-			
-			if (ball.getVelocityX() > settings.maxBallVelocity) {
-				ball.setVelocityX(settings.maxBallVelocity);
-			} else if (ball.getVelocityX() < -settings.maxBallVelocity) {
-				ball.setVelocityX(-settings.maxBallVelocity);
-			}
-			
-			if (ball.getVelocityY() > settings.maxBallVelocity) {
-				ball.setVelocityY(settings.maxBallVelocity);
-			} else if (ball.getVelocityY() < -settings.maxBallVelocity) {
-				ball.setVelocityY(-settings.maxBallVelocity);
-			}
-		}
-	}
-	
-	updatePlayers();
-	updatePhysics(dt * settings.speed);
-}
-
-void Game::activatePlayer(int num) {
-	player[num].active = true;
-}
-
-void Game::deactivatePlayer(int num) {
-	player[num].active = false;
-}
-
-bool Game::playerIsActive(int num) {
-	return player[num].active;
-}
-
-const Player& Game::getPlayer(int num) {
-	return player[num];
-}
-
-const GameStats& Game::getStats() {
-	return stats;
-}
-
-const GameUtility& Game::getUtility() {
-	return utility;
-}
-
-void Game::changeStartDelay(float _startDelay) {
-	settings.startDelay = _startDelay;
-}
-
-float Game::getStartDelay() {
-	return settings.startDelay;
-}
-
-bool Game::ballIsPaused() {
-	return pauseBall;
-}
-
-float Game::currentStartTime() {
-	return startTimer;
-}
-
-void Game::changeBallInitialVelocity(physics::vector2d velocity) {
-	settings.ballInitialVelocity = velocity;
-}
-
-float Game::XpositionOfHorizontalWall(int num) {
-	return horizontalWalls[num].getPosition().x - horizontalWalls[num].getExtent();
-}
-
-float Game::YpositionOfHorizontalWall(int num) {
-	return horizontalWalls[num].getPosition().y;
-}
-
-float Game::widthOfHorizontalWall(int num) {
-	return horizontalWalls[num].getExtent() * 2.0f;
-}
-
-float Game::XpositionOfVerticalWall(int num) {
-	return verticalWalls[num].getPosition().x;
-}
-
-float Game::YpositionOfVerticalWall(int num) {
-	return verticalWalls[num].getPosition().y + verticalWalls[num].getExtent();
-}
-
-float Game::heightOfVerticalWall(int num) {
-	return verticalWalls[num].getExtent() * 2.0f;
-}
-
-float Game::XpositionOfBall() {
-	return ball.getPosition().x - ball.getRadius();
-}
-
-float Game::YpositionOfBall() {
-	return ball.getPosition().y + ball.getRadius();
-}
-
-float Game::diameterOfBall() {
-	return ball.getRadius() * 2.0f;
-}
-
-float Game::XpositionOfPlayer(int num) {
-	return player[num].getPaddle()->getPosition().x - player[num].getPaddle()->getExtents().x;
-}
-
-float Game::YpositionOfPlayer(int num) {
-	return player[num].getPaddle()->getPosition().y + player[num].getPaddle()->getExtents().y;
-}
-
-float Game::widthOfPlayer(int num) {
-	return player[num].getPaddle()->getExtents().x * 2.0f;
-}
-
-float Game::heightOfPlayer(int num) {
-	return player[num].getPaddle()->getExtents().y * 2.0f;
-}
-
-void Game::setBallCollidesWithWall(void (*_ballCollidesWithWall)()) {
-	ballCollidesWithWall = _ballCollidesWithWall;
-}
-
-void Game::setBallCollidesWithPaddle(void (*_ballCollidesWithPaddle)()) {
-	ballCollidesWithPaddle = _ballCollidesWithPaddle;
-}
-
-void Game::updatePlayers() {
-	for (int i = 0; i < MAX_NUM_PLAYERS; ++i) {
-		if (player[i].active && controller[i]) {
-			player[i].changeVerticalSpeedTo(controller[i]->getSpeed());
-		}
-	}
-}
-
-void Game::updatePhysics(float dt) {
-	// Ball collision check variables
-	physics::vector2d collisionPositionOfBall;
-	float timeOfCollision;
-	float ballDt = dt;
-
-	// Paddle collision check variables
-	physics::vector2d collisionPositionOfPaddle;
-	physics::vector2d paddleToBallCollisionPosition;
-	
-	// Ball collision check and update
-	if (!pauseBall) {
-		bool collision = true;
-		int collisionLoopCount = 0;
-
-		// A value of 3 is sufficient for objects moving at a quick speed, but this should be increased as the collision speed between two objects exceeds the bounds around that collision
-		int maxCollisionLoops = 3;
-
-		while (collision && collisionLoopCount < maxCollisionLoops) {
-			collision = false;
-
-			// Players
-			const Paddle* paddle;
-			for (int i = 0; i < MAX_NUM_PLAYERS; ++i) {
-				if (player[i].active) {
-					paddle = player[i].getPaddle();
-					if (physics::movingBoxesCollide(ballDt, *ball.getPhysicsObject(), *paddle->getPhysicsObject(), collisionPositionOfBall, collisionPositionOfPaddle, timeOfCollision)) {
-						collision = true;
-						if (ballCollidesWithPaddle) {
-							ballCollidesWithPaddle();
-						}
-
-						player[i].setPosition(collisionPositionOfPaddle);
-						ball.setPosition(collisionPositionOfBall);
-						paddleToBallCollisionPosition = collisionPositionOfBall - collisionPositionOfPaddle;
-				
-						// Traditional physics except just bounce off top of paddle
-						float paddleToBallLengthY = paddleToBallCollisionPosition.y;
-						if (paddleToBallLengthY < 0) {
-							paddleToBallLengthY = -paddleToBallLengthY;
-						}
-						if (paddleToBallLengthY >= ball.getPhysicsObject()->extents.y + paddle->getPhysicsObject()->extents.y) {
-							if (paddleToBallCollisionPosition.y >= 0) {
-								// This is so the paddle will never shove the ball through another object
-								if (player[i].getPaddle()->getVelocity().y > 0) {
-									player[i].changeVerticalSpeedTo(0);
-								}
-
-								if (ball.getPhysicsObject()->velocity.y < 0) {
-									ball.reverseVelocityY();
-								}
-							} else {
-								// This is so the paddle will never shove the ball through another object
-								if (player[i].getPaddle()->getVelocity().y < 0) {
-									player[i].changeVerticalSpeedTo(0);
-								}
-
-								if (ball.getPhysicsObject()->velocity.y > 0) {
-									ball.reverseVelocityY();
-								}
-							}
-						} else {
-							if (paddleToBallCollisionPosition.x >= 0) {
-								// This is so the paddle will never shove the ball through another object
-								if (player[i].getPaddle()->getVelocity().x > 0) {
-									player[i].changeHorizontalSpeedTo(0);
-								}
-
-								if (ball.getPhysicsObject()->velocity.x < 0) {
-									ball.reverseVelocityX();
-								}
-							} else {
-								// This is so the paddle will never shove the ball through another object
-								if (player[i].getPaddle()->getVelocity().x < 0) {
-									player[i].changeHorizontalSpeedTo(0);
-								}
-
-								if (ball.getPhysicsObject()->velocity.x > 0) {
-									ball.reverseVelocityX();
-								}
-							}
-							// Magic number!
-							ball.setVelocityY(paddleToBallCollisionPosition.y * 11.0f);
-						}
-
-						// TMP interdasting physics but uses math.h
-						/*
-						float ballVelocityMag = sqrt(powf(ball.getPhysicsObject()->velocity.x, 2.0f) + powf(ball.getPhysicsObject()->velocity.y, 2.0f));
-						float paddleToBallMag = sqrt(powf(paddleToBallCollisionPosition.x, 2.0f) + powf(paddleToBallCollisionPosition.y, 2.0f));
-						paddleToBallCollisionPosition = (paddleToBallCollisionPosition / paddleToBallMag) * ballVelocityMag;
-						if (paddleToBallCollisionPosition.x > 0 && paddleToBallCollisionPosition.x < 1) {
-							paddleToBallCollisionPosition.x = 1;
-						}
-						if (paddleToBallCollisionPosition.x < 0 && paddleToBallCollisionPosition.x > -1) {
-							paddleToBallCollisionPosition.x = -1;
-						}
-						ball.setVelocityX(paddleToBallCollisionPosition.x);
-						ball.setVelocityY(paddleToBallCollisionPosition.y);
-						*/
-
-						ballDt = ballDt * (1.0f - timeOfCollision);
-					}
-				}
-			}
-
-			// Vertical walls
-			for (int i = 0; i < NUM_VERTICAL_WALLS; ++i) {
-				if (physics::movingBoxCollidesWithVerticalLine(ballDt, *ball.getPhysicsObject(), *verticalWalls[i].getPhysicsObject(), collisionPositionOfBall, timeOfCollision)) {
-					collision = true;
-					if (ballCollidesWithWall) {
-						ballCollidesWithWall();
-					}
-					
-					ball.setPosition(collisionPositionOfBall);
-
-					if (ball.getPosition().x >= verticalWalls[i].getPosition().x) {
-						if (ball.getPhysicsObject()->velocity.x < 0) {
-							ball.reverseVelocityX();
-						}
-					} else {
-						if (ball.getPhysicsObject()->velocity.x > 0) {
-							ball.reverseVelocityX();
-						}
-					}
-
-					ballDt = ballDt * (1.0f - timeOfCollision);
-				}
-			}
-
-			// Horizontal walls
-			for (int i = 0; i < NUM_HORIZONTAL_WALLS; ++i) {
-				if (physics::movingBoxCollidesWithHorizontalLine(ballDt, *ball.getPhysicsObject(), *horizontalWalls[i].getPhysicsObject(), collisionPositionOfBall, timeOfCollision)) {
-					collision = true;
-					if (ballCollidesWithWall) {
-						ballCollidesWithWall();
-					}
-
-					ball.setPosition(collisionPositionOfBall);
-
-					if (ball.getPosition().y >= horizontalWalls[i].getPosition().y) {
-						if (ball.getPhysicsObject()->velocity.y < 0) {
-							ball.reverseVelocityY();
-						}
-					} else {
-						if (ball.getPhysicsObject()->velocity.y > 0) {
-							ball.reverseVelocityY();
-						}
-					}
-
-					ballDt = ballDt * (1.0f - timeOfCollision);
-				}
-			}
-
-			++collisionLoopCount;
-		}
-
-		// Update
-		ball.updatePhysics(ballDt);
-	}
-
-	// Players collision check and update
-	const Paddle* paddle;
-	for (int i = 0; i < MAX_NUM_PLAYERS; ++i) {
-		if (player[i].active) {
-			paddle = player[i].getPaddle();
-
-			// Horizontal walls
-			for (int j = 0; j < NUM_HORIZONTAL_WALLS; ++j) {
-				if (physics::movingBoxCollidesWithHorizontalLine(dt, *paddle->getPhysicsObject(), *horizontalWalls[j].getPhysicsObject(), collisionPositionOfPaddle, timeOfCollision)) {
-
-					// Since collision with the ball can adjust the paddle's position, we want to make sure the paddle doesn't go through the wall
-					player[i].setPosition(physics::paddedCollisionPosition(collisionPositionOfPaddle, paddle->getPhysicsObject()->extents, horizontalWalls[j].getPosition(), horizontalWalls[j].getExtents()));
-
-					// Stop the paddle from entering the wall
-					if (collisionPositionOfPaddle.y >= horizontalWalls[j].getPosition().y) {
-						if (player[i].getPaddle()->getVelocity().y < 0) {
-							player[i].changeVerticalSpeedTo(0);
-						}
-					} else {
-						if (player[i].getPaddle()->getVelocity().y > 0) {
-							player[i].changeVerticalSpeedTo(0);
-						}
-					}
-				}
-			}
-
-			// Vertical walls
-			for (int j = 0; j < NUM_VERTICAL_WALLS; ++j) {
-				if (physics::movingBoxCollidesWithVerticalLine(dt, *paddle->getPhysicsObject(), *verticalWalls[j].getPhysicsObject(), collisionPositionOfPaddle, timeOfCollision)) {
-
-					// Since collision with the ball can adjust the paddle's position, we want to make sure the paddle doesn't go through the wall
-					player[i].setPosition(physics::paddedCollisionPosition(collisionPositionOfPaddle, paddle->getPhysicsObject()->extents, verticalWalls[j].getPosition(), verticalWalls[j].getExtents()));
-
-					// Stop the paddle from entering the wall
-					if (collisionPositionOfPaddle.x >= verticalWalls[j].getPosition().x) {
-						if (player[i].getPaddle()->getVelocity().x < 0) {
-							player[i].changeHorizontalSpeedTo(0);
-						}
-					} else {
-						if (player[i].getPaddle()->getVelocity().x > 0) {
-							player[i].changeHorizontalSpeedTo(0);
-						}
-					}
-				}
-			}
-
-			// Update
-			player[i].update(dt);
-		}
-	}
-}
\ No newline at end of file
+#include "game.h"
+#include "collision2d.h"
+#include "inputlog.h"
+
+// Broad phase proxy layout, registered in this order by setup
+#define HORIZONTAL_WALL_PROXY(i) (i)
+#define VERTICAL_WALL_PROXY(i) (NUM_HORIZONTAL_WALLS + (i))
+#define SEGMENT_WALL_PROXY(i) (NUM_HORIZONTAL_WALLS + NUM_VERTICAL_WALLS + (i))
+#define PADDLE_PROXY(i) (SEGMENT_WALL_PROXY(MAX_SEGMENT_WALLS) + (i))
+#define BALL_PROXY(i) (PADDLE_PROXY(MAX_NUM_PLAYERS) + (i))
+#define PROXY_BIT(proxy) (1ul << (proxy))
+#define WALL_PROXY_BITS (PROXY_BIT(PADDLE_PROXY(0)) - 1)
+#define AXIS_WALL_PROXY_BITS (PROXY_BIT(SEGMENT_WALL_PROXY(0)) - 1)
+
+// Balls only ever collect wall and paddle proxies in their candidate masks
+static_assert(PADDLE_PROXY(MAX_NUM_PLAYERS) <= 32, "wall and paddle proxies must fit a 32-bit candidate mask");
+
+// Broad phase categories
+enum {
+	BALL_CATEGORY = 1,
+	PADDLE_CATEGORY = 2,
+	WALL_CATEGORY = 4,
+	SEGMENT_WALL_CATEGORY = 8
+};
+
+template <class Config>
+BasicGame<Config>::BasicGame(int _screenWidth, int _screenHeight, int _physicsToPixelRatio) {
+	setupUtility(utility, _screenWidth, _screenHeight, _physicsToPixelRatio);
+	init();
+}
+
+template <class Config>
+BasicGame<Config>::BasicGame() {
+	init();
+}
+
+template <class Config>
+void BasicGame<Config>::init() {
+	// Snapshots and state hashes take every slot, including the ones past the configuration's counts that reset never touches
+	entities.balls.clear();
+	entities.paddles.clear();
+
+	// Slots past the configuration's players are never played
+	for (int i = 0; i < MAX_NUM_PLAYERS; ++i) {
+		controller[i] = 0;
+		paddles[i].bind(&entities.paddles, i);
+		player[i].active = i < Config::players;
+	}
+
+	for (int i = 0; i < MAX_NUM_BALLS; ++i) {
+		ball[i].bind(&entities.balls, i);
+		wallImpactTime[i] = 0;
+		wallImpactValid[i] = false;
+	}
+
+	accumulator = 0;
+	renderAlpha = 1;
+	recorder = 0;
+	keyframeNeeded = true;
+}
+
+template <class Config>
+void BasicGame<Config>::setup(GameSettings _settings) {
+	// Settings, with whatever the configuration fixes written over them
+	settings = _settings;
+	Config::applyCourt(settings);
+	if (settings.numSegmentWalls > Config::segmentWalls) {
+		settings.numSegmentWalls = Config::segmentWalls;
+	}
+	if (settings.numBalls < 1) {
+		settings.numBalls = 1;
+	} else if (settings.numBalls > Config::balls) {
+		settings.numBalls = Config::balls;
+	}
+
+	// Walls never move, so their bounds are baked here once for the sweep kernels and the broad phase
+	for (int i = 0; i < NUM_HORIZONTAL_WALLS; ++i) {
+		horizontalWalls[i].setup(settings.horizontalWallPoints[i], settings.horizontalWallLengths[i]);
+		horizontalWallBounds[i] = physics::lineBounds(*horizontalWalls[i].getPhysicsObject());
+	}
+
+	for (int i = 0; i < NUM_VERTICAL_WALLS; ++i) {
+		verticalWalls[i].setup(settings.verticalWallPoints[i], settings.verticalWallLengths[i]);
+		verticalWallBounds[i] = physics::lineBounds(*verticalWalls[i].getPhysicsObject());
+	}
+
+	// Segment normals are worked out here so bounces off them never need a square root
+	for (int i = 0; i < MAX_SEGMENT_WALLS; ++i) {
+		segmentWalls[i] = physics::makeSegment(settings.segmentWallStarts[i], settings.segmentWallEnds[i]);
+	}
+
+	// Smallest thing the ball can hit, or be
+	physics::scalar minColliderSize = settings.ballDiameter;
+	for (int i = 0; i < Config::players; ++i) {
+		if (settings.playerLength[i] < minColliderSize) {
+			minColliderSize = settings.playerLength[i];
+		}
+		if (settings.playerHeight[i] < minColliderSize) {
+			minColliderSize = settings.playerHeight[i];
+		}
+	}
+	for (int i = 0; i < NUM_VERTICAL_WALLS; ++i) {
+		if (settings.verticalWallLengths[i] < minColliderSize) {
+			minColliderSize = settings.verticalWallLengths[i];
+		}
+	}
+	inverseMinColliderSize = physics::reciprocal(minColliderSize);
+
+	// Wall targets for the batched sweep share the wall proxies' numbering
+	wallTargets.clear();
+	for (int i = 0; i < NUM_HORIZONTAL_WALLS; ++i) {
+		wallTargets.add(horizontalWallBounds[i]);
+	}
+	for (int i = 0; i < NUM_VERTICAL_WALLS; ++i) {
+		wallTargets.add(verticalWallBounds[i]);
+	}
+
+	// Wall proxies are final; paddles and balls are updated every tick
+	broadPhase.clear();
+	for (int i = 0; i < NUM_HORIZONTAL_WALLS; ++i) {
+		broadPhase.add(horizontalWallBounds[i], WALL_CATEGORY, 0);
+	}
+	for (int i = 0; i < NUM_VERTICAL_WALLS; ++i) {
+		broadPhase.add(verticalWallBounds[i], WALL_CATEGORY, 0);
+	}
+	for (int i = 0; i < MAX_SEGMENT_WALLS; ++i) {
+		broadPhase.add(segmentWalls[i].bounds, i < settings.numSegmentWalls ? SEGMENT_WALL_CATEGORY : 0, 0);
+	}
+	for (int i = 0; i < MAX_NUM_PLAYERS; ++i) {
+		broadPhase.add(physics::Bounds(), i < Config::players ? PADDLE_CATEGORY : 0, i < Config::players ? WALL_CATEGORY : 0);
+	}
+	for (int i = 0; i < MAX_NUM_BALLS; ++i) {
+		broadPhase.add(physics::Bounds(), i < Config::balls ? BALL_CATEGORY : 0, i < Config::balls ? PADDLE_CATEGORY | WALL_CATEGORY | SEGMENT_WALL_CATEGORY : 0);
+	}
+	
+	resetPlayersAndBall();
+	resetScore();
+}
+
+template <class Config>
+void BasicGame<Config>::resetPlayersAndBall() {
+	keyframeNeeded = true;
+	startTimer = 0;
+	pauseBall = true;
+	ballVelocityIncreaseTimer = 0;
+
+	// Randomize ball take-off
+	bool reverseX = prng.next() & 1;
+	bool reverseY = prng.below(3) == 0;
+
+	for (int i = 0; i < Config::balls; ++i) {
+		ball[i].setup(settings.ballInitialPoint, settings.ballDiameter, settings.ballInitialVelocity);
+		wallImpactTime[i] = 0;
+		wallImpactValid[i] = false;
+		if (i >= settings.numBalls) {
+			ball[i].setActive(false);
+			continue;
+		}
+
+		// Extra balls leave towards alternating corners at steeper and steeper angles
+		if (i % 2) {
+			ball[i].reverseVelocityX();
+		}
+		if ((i / 2) % 2) {
+			ball[i].reverseVelocityY();
+		}
+		ball[i].setVelocityY(ball[i].getVelocityY() * (1.0f + (i / 4) * 0.25f));
+
+		if (reverseX) {
+			ball[i].reverseVelocityX();
+		}
+		if (reverseY) {
+			ball[i].reverseVelocityY();
+		}
+	}
+
+	for (int i = 0; i < MAX_NUM_PLAYERS; ++i) {
+		paddles[i].setup(settings.playerInitialPoint[i], settings.playerLength[i], settings.playerHeight[i]);
+		player[i].setup(&paddles[i], settings.playerMaxMoveSpeed[i]);
+	}
+
+	// Nothing to blend from after a reset
+	savePreviousPositions();
+}
+
+template <class Config>
+void BasicGame<Config>::resetScore() {
+	keyframeNeeded = true;
+	stats.leftScore = 0;
+	stats.rightScore = 0;
+	stats.tick = 0;
+	stats.collisionIterations = 0;
+	stats.maxCollisionIterations = 0;
+	stats.substeps = 0;
+	stats.contactLimitHits = 0;
+	stats.tunnelingEvents = 0;
+	stats.wallPredictionHits = 0;
+	stats.wallPredictionMisses = 0;
+	stats.droppedCollisionEvents = 0;
+}
+
+template <class Config>
+void BasicGame<Config>::assignController(int playerNum, PlayerController* _controller) {
+	controller[playerNum] = _controller;
+	keyframeNeeded = true;
+}
+
+// Every ball that leaves the court scores, and the round is over once the last one has gone
+template <class Config>
+bool BasicGame<Config>::winCondition() {
+	bool ballInPlay = false;
+	for (int i = 0; i < settings.numBalls; ++i) {
+		if (!ball[i].isActive()) {
+			continue;
+		}
+
+		if (ball[i].getPosition().x + ball[i].getRadius() + 1 < 0) {
+			++stats.rightScore;
+			ball[i].setActive(false);
+			keyframeNeeded = true;
+		} else if (ball[i].getPosition().x - ball[i].getRadius() - 1 > utility.screenToPhysics(utility.screenWidth - 1)) {
+			++stats.leftScore;
+			ball[i].setActive(false);
+			keyframeNeeded = true;
+		} else {
+			ballInPlay = true;
+		}
+	}
+	return !ballInPlay;
+}
+
+template <class Config>
+void BasicGame<Config>::tick(float _dt) {
+	physics::scalar dt = _dt;
+
+	if (recorder && keyframeNeeded) {
+		uint8_t controlled = 0;
+		for (int i = 0; i < MAX_NUM_PLAYERS; ++i) {
+			if (controller[i]) {
+				controlled |= 1 << i;
+			}
+		}
+		GameSnapshot snapshot;
+		save(snapshot);
+		recorder->keyframe(controlled, snapshot);
+	}
+	keyframeNeeded = false;
+
+	++stats.tick;
+
+	// Called directly, tick() leaves things drawn where this step puts them
+	savePreviousPositions();
+	renderAlpha = 1;
+	
+	if (startTimer >= 0) {
+		startTimer += dt;
+		if (startTimer >= settings.startDelay) {
+			startTimer = -1;
+			pauseBall = false;
+		}
+	}
+	
+	if (!pauseBall) {
+		ballVelocityIncreaseTimer += dt;
+		if (ballVelocityIncreaseTimer >= settings.ballVelocityIncreaseInterval) {
+			ballVelocityIncreaseTimer = 0;
+			for (int i = 0; i < settings.numBalls; ++i) {
+				ball[i].increaseVelocity(settings.ballVelocityIncrease);
+				wallImpactValid[i] = false;
+				
+				if (ball[i].getVelocityX() > settings.maxBallVelocity) {
+					ball[i].setVelocityX(settings.maxBallVelocity);
+				} else if (ball[i].getVelocityX() < -settings.maxBallVelocity) {
+					ball[i].setVelocityX(-settings.maxBallVelocity);
+				}
+				
+				if (ball[i].getVelocityY() > settings.maxBallVelocity) {
+					ball[i].setVelocityY(settings.maxBallVelocity);
+				} else if (ball[i].getVelocityY() < -settings.maxBallVelocity) {
+					ball[i].setVelocityY(-settings.maxBallVelocity);
+				}
+			}
+		}
+	}
+	
+	updatePlayers();
+
+	physics::scalar physicsDt = dt * settings.speed;
+	int substeps = physicsSubsteps(physicsDt);
+	physicsDt = physicsDt / substeps;
+
+	stats.substeps = substeps;
+	stats.collisionIterations = 0;
+	for (int i = 0; i < substeps; ++i) {
+		stepStartTime = physicsDt * i;
+		updatePhysics(physicsDt);
+	}
+
+	if (recorder) {
+		float speeds[MAX_NUM_PLAYERS];
+		for (int i = 0; i < MAX_NUM_PLAYERS; ++i) {
+			speeds[i] = controller[i] ? controller[i]->getSpeed() : 0;
+		}
+		recorder->tick(_dt, speeds, stateHash());
+	}
+}
+
+// Runs as many fixed physics steps as the real time since the last call adds up to, and returns how many ran
+// The time left over sets how far between the last two steps balls and players are drawn
+template <class Config>
+int BasicGame<Config>::advance(float realDt) {
+	const float stepDt = 1.0f / PHYSICS_STEP_RATE;
+
+	accumulator += realDt;
+	if (accumulator > stepDt * MAX_PHYSICS_STEPS_PER_ADVANCE) {
+		accumulator = stepDt * MAX_PHYSICS_STEPS_PER_ADVANCE;
+	}
+
+	int steps = 0;
+	while (accumulator >= stepDt) {
+		tick(stepDt);
+		accumulator -= stepDt;
+		++steps;
+	}
+
+	renderAlpha = accumulator / stepDt;
+	return steps;
+}
+
+template <class Config>
+float BasicGame<Config>::interpolation() {
+	return physics::toFloat(renderAlpha);
+}
+
+template <class Config>
+void BasicGame<Config>::activatePlayer(int num) {
+	player[num].active = num < Config::players;
+	keyframeNeeded = true;
+}
+
+template <class Config>
+void BasicGame<Config>::deactivatePlayer(int num) {
+	player[num].active = false;
+	keyframeNeeded = true;
+}
+
+template <class Config>
+bool BasicGame<Config>::playerIsActive(int num) {
+	return player[num].active;
+}
+
+template <class Config>
+const Player& BasicGame<Config>::getPlayer(int num) {
+	return player[num];
+}
+
+template <class Config>
+const Ball& BasicGame<Config>::getBall(int num) {
+	return ball[num];
+}
+
+template <class Config>
+const GameStats& BasicGame<Config>::getStats() {
+	return stats;
+}
+
+template <class Config>
+const typename Config::Utility& BasicGame<Config>::getUtility() {
+	return utility;
+}
+
+template <class Config>
+void BasicGame<Config>::changeStartDelay(float _startDelay) {
+	settings.startDelay = _startDelay;
+	keyframeNeeded = true;
+}
+
+template <class Config>
+float BasicGame<Config>::getStartDelay() {
+	return physics::toFloat(settings.startDelay);
+}
+
+template <class Config>
+bool BasicGame<Config>::ballIsPaused() {
+	return pauseBall;
+}
+
+template <class Config>
+float BasicGame<Config>::currentStartTime() {
+	return physics::toFloat(startTimer);
+}
+
+template <class Config>
+void BasicGame<Config>::changeBallInitialVelocity(physics::vector2d velocity) {
+	settings.ballInitialVelocity = velocity;
+	keyframeNeeded = true;
+}
+
+template <class Config>
+void BasicGame<Config>::changeNumberOfBalls(int num) {
+	if (num < 1) {
+		num = 1;
+	} else if (num > Config::balls) {
+		num = Config::balls;
+	}
+	settings.numBalls = num;
+	keyframeNeeded = true;
+}
+
+template <class Config>
+int BasicGame<Config>::numberOfBalls() {
+	return settings.numBalls;
+}
+
+template <class Config>
+bool BasicGame<Config>::ballIsActive(int num) {
+	return ball[num].isActive();
+}
+
+template <class Config>
+float BasicGame<Config>::XpositionOfHorizontalWall(int num) {
+	return physics::toFloat(horizontalWalls[num].getPosition().x - horizontalWalls[num].getExtent());
+}
+
+template <class Config>
+float BasicGame<Config>::YpositionOfHorizontalWall(int num) {
+	return physics::toFloat(horizontalWalls[num].getPosition().y);
+}
+
+template <class Config>
+float BasicGame<Config>::widthOfHorizontalWall(int num) {
+	return physics::toFloat(horizontalWalls[num].getExtent()) * 2.0f;
+}
+
+template <class Config>
+float BasicGame<Config>::XpositionOfVerticalWall(int num) {
+	return physics::toFloat(verticalWalls[num].getPosition().x);
+}
+
+template <class Config>
+float BasicGame<Config>::YpositionOfVerticalWall(int num) {
+	return physics::toFloat(verticalWalls[num].getPosition().y + verticalWalls[num].getExtent());
+}
+
+template <class Config>
+float BasicGame<Config>::heightOfVerticalWall(int num) {
+	return physics::toFloat(verticalWalls[num].getExtent()) * 2.0f;
+}
+
+template <class Config>
+int BasicGame<Config>::numberOfSegmentWalls() {
+	return settings.numSegmentWalls;
+}
+
+template <class Config>
+float BasicGame<Config>::XstartOfSegmentWall(int num) {
+	return physics::toFloat(segmentWalls[num].start.x);
+}
+
+template <class Config>
+float BasicGame<Config>::YstartOfSegmentWall(int num) {
+	return physics::toFloat(segmentWalls[num].start.y);
+}
+
+template <class Config>
+float BasicGame<Config>::XendOfSegmentWall(int num) {
+	return physics::toFloat(segmentWalls[num].end.x);
+}
+
+template <class Config>
+float BasicGame<Config>::YendOfSegmentWall(int num) {
+	return physics::toFloat(segmentWalls[num].end.y);
+}
+
+template <class Config>
+float BasicGame<Config>::XpositionOfBall(int num) {
+	return physics::toFloat(interpolatedPosition(previousBallPosition[num], ball[num].getPosition()).x - ball[num].getRadius());
+}
+
+template <class Config>
+float BasicGame<Config>::YpositionOfBall(int num) {
+	return physics::toFloat(interpolatedPosition(previousBallPosition[num], ball[num].getPosition()).y + ball[num].getRadius());
+}
+
+template <class Config>
+float BasicGame<Config>::diameterOfBall(int num) {
+	return physics::toFloat(ball[num].getRadius()) * 2.0f;
+}
+
+template <class Config>
+float BasicGame<Config>::XpositionOfPlayer(int num) {
+	return physics::toFloat(interpolatedPosition(previousPaddlePosition[num], player[num].getPaddle()->getPosition()).x - player[num].getPaddle()->getExtents().x);
+}
+
+template <class Config>
+float BasicGame<Config>::YpositionOfPlayer(int num) {
+	return physics::toFloat(interpolatedPosition(previousPaddlePosition[num], player[num].getPaddle()->getPosition()).y + player[num].getPaddle()->getExtents().y);
+}
+
+template <class Config>
+float BasicGame<Config>::widthOfPlayer(int num) {
+	return physics::toFloat(player[num].getPaddle()->getExtents().x) * 2.0f;
+}
+
+template <class Config>
+float BasicGame<Config>::heightOfPlayer(int num) {
+	return physics::toFloat(player[num].getPaddle()->getExtents().y) * 2.0f;
+}
+
+template <class Config>
+bool BasicGame<Config>::nextCollisionEvent(CollisionEvent& event) {
+	return collisionEvents.pop(event);
+}
+
+template <class Config>
+void BasicGame<Config>::save(GameSnapshot& snapshot) const {
+	snapshot.entities = entities;
+	for (int i = 0; i < MAX_NUM_PLAYERS; ++i) {
+		snapshot.playerActive[i] = player[i].active;
+	}
+	snapshot.stats = stats;
+
+	snapshot.numBalls = settings.numBalls;
+	snapshot.ballInitialVelocity = settings.ballInitialVelocity;
+	snapshot.startDelay = settings.startDelay;
+
+	for (int i = 0; i < MAX_NUM_BALLS; ++i) {
+		snapshot.wallImpactTime[i] = wallImpactTime[i];
+		snapshot.wallImpactValid[i] = wallImpactValid[i];
+	}
+	snapshot.startTimer = startTimer;
+	snapshot.ballVelocityIncreaseTimer = ballVelocityIncreaseTimer;
+	snapshot.pauseBall = pauseBall;
+	snapshot.randomState = prng.state;
+}
+
+// Balls and paddles are handles into entities, so copying the arrays back is all it takes to move them
+template <class Config>
+void BasicGame<Config>::restore(const GameSnapshot& snapshot) {
+	entities = snapshot.entities;
+	for (int i = 0; i < MAX_NUM_PLAYERS; ++i) {
+		player[i].active = snapshot.playerActive[i] && i < Config::players;
+	}
+	stats = snapshot.stats;
+
+	settings.numBalls = snapshot.numBalls;
+	settings.ballInitialVelocity = snapshot.ballInitialVelocity;
+	settings.startDelay = snapshot.startDelay;
+
+	for (int i = 0; i < MAX_NUM_BALLS; ++i) {
+		wallImpactTime[i] = snapshot.wallImpactTime[i];
+		wallImpactValid[i] = snapshot.wallImpactValid[i];
+	}
+	startTimer = snapshot.startTimer;
+	ballVelocityIncreaseTimer = snapshot.ballVelocityIncreaseTimer;
+	pauseBall = snapshot.pauseBall;
+	prng.state = snapshot.randomState;
+	keyframeNeeded = true;
+
+	// Drawn where the snapshot left things, with nothing to blend from
+	savePreviousPositions();
+	renderAlpha = 1;
+}
+
+template <class Config>
+void BasicGame<Config>::seed(uint32_t seed) {
+	prng.setSeed(seed);
+	keyframeNeeded = true;
+}
+
+template <class Config>
+void BasicGame<Config>::record(InputRecorder* _recorder) {
+	recorder = _recorder;
+	if (recorder) {
+		// Logs always carry the screen as numbers, fixed or not
+		GameUtility screen = {utility.screenWidth, utility.screenHeight, utility.physicsToPixelRatio};
+		recorder->begin(screen, settings);
+		keyframeNeeded = true;
+	}
+}
+
+// FNV-1a over the raw bytes; the arrays are all 4-byte values or bools, so there's no padding to pick up
+static uint32_t hashBytes(uint32_t hash, const void* data, int size) {
+	const uint8_t* bytes = (const uint8_t*)data;
+	for (int i = 0; i < size; ++i) {
+		hash = (hash ^ bytes[i]) * 16777619u;
+	}
+	return hash;
+}
+
+template <int Capacity>
+static uint32_t hashBodies(uint32_t hash, const BodyArrays<Capacity>& bodies) {
+	hash = hashBytes(hash, bodies.positionX, sizeof(bodies.positionX));
+	hash = hashBytes(hash, bodies.positionY, sizeof(bodies.positionY));
+	hash = hashBytes(hash, bodies.extentX, sizeof(bodies.extentX));
+	hash = hashBytes(hash, bodies.extentY, sizeof(bodies.extentY));
+	hash = hashBytes(hash, bodies.velocityX, sizeof(bodies.velocityX));
+	hash = hashBytes(hash, bodies.velocityY, sizeof(bodies.velocityY));
+	return hashBytes(hash, bodies.active, sizeof(bodies.active));
+}
+
+template <class Config>
+uint32_t BasicGame<Config>::stateHash() {
+	GameSnapshot snapshot;
+	save(snapshot);
+
+	uint32_t hash = 2166136261u;
+	hash = hashBodies(hash, snapshot.entities.balls);
+	hash = hashBodies(hash, snapshot.entities.paddles);
+	hash = hashBytes(hash, snapshot.playerActive, sizeof(snapshot.playerActive));
+	hash = hashBytes(hash, &snapshot.stats.leftScore, sizeof(snapshot.stats.leftScore));
+	hash = hashBytes(hash, &snapshot.stats.rightScore, sizeof(snapshot.stats.rightScore));
+	hash = hashBytes(hash, &snapshot.stats.tick, sizeof(snapshot.stats.tick));
+	hash = hashBytes(hash, &snapshot.numBalls, sizeof(snapshot.numBalls));
+	hash = hashBytes(hash, &snapshot.ballInitialVelocity, sizeof(snapshot.ballInitialVelocity));
+	hash = hashBytes(hash, &snapshot.startDelay, sizeof(snapshot.startDelay));
+	hash = hashBytes(hash, snapshot.wallImpactTime, sizeof(snapshot.wallImpactTime));
+	hash = hashBytes(hash, snapshot.wallImpactValid, sizeof(snapshot.wallImpactValid));
+	hash = hashBytes(hash, &snapshot.startTimer, sizeof(snapshot.startTimer));
+	hash = hashBytes(hash, &snapshot.ballVelocityIncreaseTimer, sizeof(snapshot.ballVelocityIncreaseTimer));
+	hash = hashBytes(hash, &snapshot.pauseBall, sizeof(snapshot.pauseBall));
+	return hashBytes(hash, &snapshot.randomState, sizeof(snapshot.randomState));
+}
+
+template <class Config>
+void BasicGame<Config>::updatePlayers() {
+	for (int i = 0; i < Config::players; ++i) {
+		if (player[i].active && controller[i]) {
+			player[i].changeVerticalSpeedTo(controller[i]->getSpeed());
+		}
+	}
+}
+
+template <class Config>
+void BasicGame<Config>::savePreviousPositions() {
+	for (int i = 0; i < Config::balls; ++i) {
+		previousBallPosition[i] = ball[i].getPosition();
+	}
+	for (int i = 0; i < Config::players; ++i) {
+		previousPaddlePosition[i] = paddles[i].getPosition();
+	}
+}
+
+template <class Config>
+physics::vector2d BasicGame<Config>::interpolatedPosition(physics::vector2d previous, physics::vector2d current) {
+	return previous + (current - previous) * renderAlpha;
+}
+
+// Enough steps that no ball closes in on a paddle by more than the smallest collider in one step
+// Axes are taken separately, since that's how deep an axis-aligned box can sink into another
+template <class Config>
+int BasicGame<Config>::physicsSubsteps(physics::scalar dt) {
+	physics::scalar maxBallSpeed = 0;
+	if (!pauseBall) {
+		for (int i = 0; i < settings.numBalls; ++i) {
+			if (!entities.balls.active[i]) {
+				continue;
+			}
+			physics::scalar speedX = entities.balls.velocityX[i] < 0 ? -entities.balls.velocityX[i] : entities.balls.velocityX[i];
+			physics::scalar speedY = entities.balls.velocityY[i] < 0 ? -entities.balls.velocityY[i] : entities.balls.velocityY[i];
+			if (speedX > maxBallSpeed) {
+				maxBallSpeed = speedX;
+			}
+			if (speedY > maxBallSpeed) {
+				maxBallSpeed = speedY;
+			}
+		}
+	}
+
+	physics::scalar maxPaddleSpeed = 0;
+	for (int i = 0; i < Config::players; ++i) {
+		if (!player[i].active) {
+			continue;
+		}
+		physics::scalar speedX = entities.paddles.velocityX[i] < 0 ? -entities.paddles.velocityX[i] : entities.paddles.velocityX[i];
+		physics::scalar speedY = entities.paddles.velocityY[i] < 0 ? -entities.paddles.velocityY[i] : entities.paddles.velocityY[i];
+		if (speedX > maxPaddleSpeed) {
+			maxPaddleSpeed = speedX;
+		}
+		if (speedY > maxPaddleSpeed) {
+			maxPaddleSpeed = speedY;
+		}
+	}
+
+	int substeps = 1 + int(physics::toFloat((maxBallSpeed + maxPaddleSpeed) * dt * inverseMinColliderSize));
+	return substeps < MAX_PHYSICS_SUBSTEPS ? substeps : MAX_PHYSICS_SUBSTEPS;
+}
+
+template <class Config>
+void BasicGame<Config>::updateBroadPhase(physics::scalar dt, uint32_t* ballCandidates, uint32_t* paddleCandidates) {
+	// Straight off the arrays, for every slot; the ones not in play are filtered out below
+	physics::Bounds paddleBounds[MAX_NUM_PLAYERS];
+	physics::Bounds ballBounds[MAX_NUM_BALLS];
+	entities.paddles.sweptBounds(dt, paddleBounds, Config::players);
+	entities.balls.sweptBounds(dt, ballBounds, Config::balls);
+
+	for (int i = 0; i < Config::players; ++i) {
+		paddleCandidates[i] = 0;
+		if (player[i].active) {
+			broadPhase.setFilter(PADDLE_PROXY(i), PADDLE_CATEGORY, WALL_CATEGORY);
+			broadPhase.update(PADDLE_PROXY(i), paddleBounds[i]);
+		} else {
+			broadPhase.setFilter(PADDLE_PROXY(i), 0, 0);
+		}
+	}
+
+	for (int i = 0; i < Config::balls; ++i) {
+		ballCandidates[i] = 0;
+		if (!pauseBall && ball[i].isActive()) {
+			broadPhase.setFilter(BALL_PROXY(i), BALL_CATEGORY, PADDLE_CATEGORY | WALL_CATEGORY | SEGMENT_WALL_CATEGORY);
+			broadPhase.update(BALL_PROXY(i), ballBounds[i]);
+		} else {
+			broadPhase.setFilter(BALL_PROXY(i), 0, 0);
+		}
+	}
+
+	physics::BroadPhasePair pairs[MAX_BROAD_PHASE_PAIRS];
+	int numPairs = broadPhase.findPairs(pairs, MAX_BROAD_PHASE_PAIRS);
+	for (int i = 0; i < numPairs; ++i) {
+		if (pairs[i].a >= BALL_PROXY(0)) {
+			ballCandidates[pairs[i].a - BALL_PROXY(0)] |= PROXY_BIT(pairs[i].b);
+		} else {
+			paddleCandidates[pairs[i].a - PADDLE_PROXY(0)] |= PROXY_BIT(pairs[i].b);
+		}
+	}
+}
+
+// Once the ball bounces its remaining path no longer matches the bounds it had at the start of the tick
+template <class Config>
+uint32_t BasicGame<Config>::findBallCandidates(int num, physics::scalar dt) {
+	uint8_t proxies[NUM_BROAD_PHASE_PROXIES];
+	int numProxies = broadPhase.query(physics::sweptBounds(dt, entities.balls.getBox(num)), PADDLE_CATEGORY | WALL_CATEGORY | SEGMENT_WALL_CATEGORY, proxies, NUM_BROAD_PHASE_PROXIES);
+
+	uint32_t candidates = 0;
+	for (int i = 0; i < numProxies; ++i) {
+		candidates |= PROXY_BIT(proxies[i]);
+	}
+	return candidates;
+}
+
+// Walls are thin boxes, so a ball level with the end of a wall hits that end rather than its side
+// Returns true when the wall pushes the ball along x, and gives where the ball is relative to the wall
+template <class Config>
+bool BasicGame<Config>::wallPushesAlongX(int num, const BallContact& contact, physics::vector2d& wallToBall) {
+	physics::vector2d extents = entities.balls.getExtents(num);
+
+	if (contact.type == CONTACT_VERTICAL_WALL) {
+		wallToBall = contact.positionOfBall - verticalWalls[contact.index].getPosition();
+		extents += verticalWalls[contact.index].getExtents();
+	} else {
+		wallToBall = contact.positionOfBall - horizontalWalls[contact.index].getPosition();
+		extents += horizontalWalls[contact.index].getExtents();
+	}
+
+	return !physics::boxesMeetAlongY(wallToBall, extents);
+}
+
+// How fast the ball closes in on the surface it touches, along the way that surface pushes it; negative when leaving
+template <class Config>
+physics::scalar BasicGame<Config>::closingSpeed(int num, const BallContact& contact) {
+	physics::vector2d velocity = entities.balls.getVelocity(num);
+
+	switch (contact.type) {
+		case CONTACT_PADDLE: {
+			physics::vector2d paddleToBall = contact.positionOfBall - contact.positionOfPaddle;
+			velocity -= entities.paddles.getVelocity(contact.index);
+
+			// Same choice of face as bounceBallOffPaddle
+			if (physics::boxesMeetAlongY(paddleToBall, entities.balls.getExtents(num) + entities.paddles.getExtents(contact.index))) {
+				return paddleToBall.y >= 0 ? -velocity.y : velocity.y;
+			}
+			return paddleToBall.x >= 0 ? -velocity.x : velocity.x;
+		}
+
+		case CONTACT_VERTICAL_WALL:
+		case CONTACT_HORIZONTAL_WALL: {
+			physics::vector2d wallToBall;
+			if (wallPushesAlongX(num, contact, wallToBall)) {
+				return wallToBall.x >= 0 ? -velocity.x : velocity.x;
+			}
+			return wallToBall.y >= 0 ? -velocity.y : velocity.y;
+		}
+
+		case CONTACT_SEGMENT_WALL:
+			return -(velocity.x * contact.normal.x + velocity.y * contact.normal.y);
+	}
+	return 0;
+}
+
+// Touching something counts as a contact at time 0, even while the ball is already leaving it
+// Only a ball closing in on the surface it touches needs a response
+template <class Config>
+bool BasicGame<Config>::ballApproaches(int num, const BallContact& contact) {
+	return closingSpeed(num, contact) > 0;
+}
+
+// Sweeps the ball against the selected walls: the axis-aligned ones in one batch, where a wall the ball is leaving is dropped and the batch run again, then the segments
+template <class Config>
+bool BasicGame<Config>::findEarliestWallContact(int num, const physics::MovingBox& ballObject, physics::scalar dt, uint32_t walls, BallContact& contact) {
+	bool found = false;
+
+	uint32_t axisWalls = walls & AXIS_WALL_PROXY_BITS;
+	while (axisWalls) {
+		int wall = physics::sweepBatch(dt, ballObject, wallTargets, axisWalls, contact.timeOfCollision);
+		if (wall < 0) {
+			break;
+		}
+
+		if (wall < VERTICAL_WALL_PROXY(0)) {
+			contact.type = CONTACT_HORIZONTAL_WALL;
+			contact.index = wall - HORIZONTAL_WALL_PROXY(0);
+		} else {
+			contact.type = CONTACT_VERTICAL_WALL;
+			contact.index = wall - VERTICAL_WALL_PROXY(0);
+		}
+		contact.positionOfBall = ballObject.position + (ballObject.velocity * dt) * contact.timeOfCollision;
+
+		if (ballApproaches(num, contact)) {
+			found = true;
+			break;
+		}
+		axisWalls &= ~PROXY_BIT(wall);
+	}
+
+	BallContact candidate;
+	candidate.type = CONTACT_SEGMENT_WALL;
+	for (int i = 0; i < Config::segmentWalls && i < settings.numSegmentWalls; ++i) {
+		candidate.index = i;
+		if ((walls & PROXY_BIT(SEGMENT_WALL_PROXY(i))) && physics::movingBoxCollidesWithSegment(dt, ballObject, segmentWalls[i], candidate.positionOfBall, candidate.timeOfCollision, candidate.normal)) {
+			if ((!found || candidate.timeOfCollision < contact.timeOfCollision) && ballApproaches(num, candidate)) {
+				found = true;
+				contact = candidate;
+			}
+		}
+	}
+	return found;
+}
+
+// Tests the ball against every candidate and keeps the approaching contact with the smallest time of impact
+template <class Config>
+bool BasicGame<Config>::findEarliestBallContact(int num, physics::scalar ballDt, uint32_t ballCandidates, BallContact& contact) {
+	physics::MovingBox ballObject = entities.balls.getBox(num);
+	BallContact candidate;
+	bool found = false;
+
+	// Players
+	candidate.type = CONTACT_PADDLE;
+	for (int i = 0; i < Config::players; ++i) {
+		candidate.index = i;
+		if (!player[i].active || !(ballCandidates & PROXY_BIT(PADDLE_PROXY(i)))) {
+			continue;
+		}
+
+		// The paddle stands where it was paddleDt before the end of the step and the ball ballDt before it, so bring the paddle up to the ball's time
+		physics::MovingBox paddleObject = entities.paddles.getBox(i);
+		paddleObject.position += paddleObject.velocity * (paddleDt[i] - ballDt);
+
+		if (physics::movingBoxesCollide(ballDt, ballObject, paddleObject, candidate.positionOfBall, candidate.positionOfPaddle, candidate.timeOfCollision)) {
+			if ((!found || candidate.timeOfCollision < contact.timeOfCollision) && ballApproaches(num, candidate)) {
+				found = true;
+				contact = candidate;
+			}
+		}
+	}
+
+	// Walls
+	if (findEarliestWallContact(num, ballObject, ballDt, ballCandidates & WALL_PROXY_BITS, candidate) && (!found || candidate.timeOfCollision < contact.timeOfCollision)) {
+		found = true;
+		contact = candidate;
+	}
+
+	return found;
+}
+
+template <class Config>
+void BasicGame<Config>::bounceBallOffPaddle(int num, int playerNum, const BallContact& contact) {
+	const Paddle* paddle = player[playerNum].getPaddle();
+
+	// Left a hair off the ball, so a paddle pressing it into a wall never closes the gap to exactly the ball's size and pins it there
+	player[playerNum].setPosition(physics::paddedCollisionPosition(contact.positionOfPaddle, paddle->getExtents(), contact.positionOfBall, entities.balls.getExtents(num)));
+	physics::vector2d paddleToBallCollisionPosition = contact.positionOfBall - contact.positionOfPaddle;
+
+	// Traditional physics except just bounce off top of paddle
+	if (physics::boxesMeetAlongY(paddleToBallCollisionPosition, entities.balls.getExtents(num) + paddle->getExtents())) {
+		if (paddleToBallCollisionPosition.y >= 0) {
+			// This is so the paddle will never shove the ball through another object
+			if (paddle->getVelocity().y > 0) {
+				player[playerNum].changeVerticalSpeedTo(0);
+			}
+
+			if (ball[num].getVelocityY() < 0) {
+				ball[num].reverseVelocityY();
+			}
+		} else {
+			// This is so the paddle will never shove the ball through another object
+			if (paddle->getVelocity().y < 0) {
+				player[playerNum].changeVerticalSpeedTo(0);
+			}
+
+			if (ball[num].getVelocityY() > 0) {
+				ball[num].reverseVelocityY();
+			}
+		}
+	} else {
+		if (paddleToBallCollisionPosition.x >= 0) {
+			// This is so the paddle will never shove the ball through another object
+			if (paddle->getVelocity().x > 0) {
+				player[playerNum].changeHorizontalSpeedTo(0);
+			}
+		} else {
+			// This is so the paddle will never shove the ball through another object
+			if (paddle->getVelocity().x < 0) {
+				player[playerNum].changeHorizontalSpeedTo(0);
+			}
+		}
+		reboundOffPaddleSide(num, paddle, paddleToBallCollisionPosition);
+	}
+}
+
+// Off a paddle's side the ball keeps its speed, but leaves at an angle set by how far from the middle it hit and how fast the paddle was moving
+template <class Config>
+void BasicGame<Config>::reboundOffPaddleSide(int num, const Paddle* paddle, physics::vector2d paddleToBall) {
+	// Scaled down so squared speeds stay in range of Q16.16
+	physics::scalar scale = PADDLE_REBOUND_VELOCITY_SCALE;
+	physics::vector2d velocity = physics::vector2d(ball[num].getVelocityX(), ball[num].getVelocityY()) * scale;
+	physics::scalar speedSquared = velocity.x * velocity.x + velocity.y * velocity.y;
+	if (speedSquared <= 0) {
+		return;
+	}
+	physics::scalar inverseSpeed = physics::inverseSqrt(speedSquared);
+
+	// Slope of the way out: -1 to 1 across the paddle and ball, times the steepest slope, plus spin from the paddle's own
+	// vertical speed as a fraction of the ball's speed; together they never go past the steepest slope
+	physics::scalar offset = paddleToBall.y * physics::reciprocal(paddle->getExtents().y + entities.balls.getExtents(num).y);
+	physics::scalar slope = offset * PADDLE_REBOUND_MAX_SLOPE + paddle->getVelocity().y * scale * inverseSpeed * PADDLE_REBOUND_SPIN;
+	physics::scalar maxSlope = PADDLE_REBOUND_MAX_SLOPE;
+	if (slope > maxSlope) {
+		slope = maxSlope;
+	} else if (slope < -maxSlope) {
+		slope = -maxSlope;
+	}
+	physics::vector2d direction(paddleToBall.x >= 0 ? 1 : -1, slope);
+
+	physics::scalar speed = speedSquared * inverseSpeed * physics::reciprocal(scale);
+	direction *= speed * physics::inverseSqrt(direction.x * direction.x + direction.y * direction.y);
+	ball[num].setVelocityX(direction.x);
+	ball[num].setVelocityY(direction.y);
+}
+
+// Moves the ball to the contact and points it away from what it hit
+template <class Config>
+void BasicGame<Config>::applyBallContact(int num, const BallContact& contact) {
+	ball[num].setPosition(contact.positionOfBall);
+	wallImpactValid[num] = false;
+
+	switch (contact.type) {
+		case CONTACT_PADDLE:
+			bounceBallOffPaddle(num, contact.index, contact);
+			break;
+
+		case CONTACT_VERTICAL_WALL:
+		case CONTACT_HORIZONTAL_WALL: {
+			physics::vector2d wallToBall;
+			if (wallPushesAlongX(num, contact, wallToBall)) {
+				if (wallToBall.x >= 0) {
+					if (ball[num].getVelocityX() < 0) {
+						ball[num].reverseVelocityX();
+					}
+				} else {
+					if (ball[num].getVelocityX() > 0) {
+						ball[num].reverseVelocityX();
+					}
+				}
+			} else {
+				if (wallToBall.y >= 0) {
+					if (ball[num].getVelocityY() < 0) {
+						ball[num].reverseVelocityY();
+					}
+				} else {
+					if (ball[num].getVelocityY() > 0) {
+						ball[num].reverseVelocityY();
+					}
+				}
+			}
+			break;
+		}
+
+		case CONTACT_SEGMENT_WALL: {
+			physics::vector2d velocity(ball[num].getVelocityX(), ball[num].getVelocityY());
+			if (velocity.x * contact.normal.x + velocity.y * contact.normal.y < 0) {
+				velocity = physics::reflect(velocity, contact.normal);
+				ball[num].setVelocityX(velocity.x);
+				ball[num].setVelocityY(velocity.y);
+			}
+			break;
+		}
+	}
+}
+
+// Called before the contact is applied, while the ball still has the velocity it hit with
+template <class Config>
+void BasicGame<Config>::queueCollisionEvent(int num, const BallContact& contact, physics::scalar timeOfImpact) {
+	CollisionEvent event;
+	event.type = contact.type;
+	event.ball = num;
+	event.index = contact.index;
+	event.position = contact.positionOfBall;
+	event.relativeSpeed = closingSpeed(num, contact);
+	event.timeOfImpact = timeOfImpact;
+	event.tick = stats.tick;
+
+	if (!collisionEvents.push(event)) {
+		++stats.droppedCollisionEvents;
+	}
+}
+
+// Time until the ball, grown by WALL_PREDICTION_SKIN, first runs into a wall at its current velocity
+// The skin keeps rounding in the integration from carrying the ball into a wall before the predicted time
+template <class Config>
+void BasicGame<Config>::predictWallImpact(int num) {
+	physics::MovingBox ballObject = entities.balls.getBox(num);
+	ballObject.extents += physics::vector2d(WALL_PREDICTION_SKIN, WALL_PREDICTION_SKIN);
+	physics::scalar horizon = WALL_PREDICTION_HORIZON;
+	BallContact candidate;
+
+	// Nothing within the horizon just means predicting again once it has passed
+	wallImpactTime[num] = horizon;
+	wallImpactValid[num] = true;
+
+	if (findEarliestWallContact(num, ballObject, horizon, WALL_PROXY_BITS, candidate)) {
+		wallImpactTime[num] = candidate.timeOfCollision * horizon;
+	}
+
+	// A skin already into a wall can side with the wrong face, e.g. off the end of a segment the ball is really coming down on,
+	// and drop the contact as leaving; the ball itself isn't in yet, so its own sweep still finds the impact
+	ballObject.extents = entities.balls.getExtents(num);
+	if (findEarliestWallContact(num, ballObject, horizon, WALL_PROXY_BITS, candidate) && candidate.timeOfCollision * horizon < wallImpactTime[num]) {
+		wallImpactTime[num] = candidate.timeOfCollision * horizon;
+	}
+}
+
+// Leaves the walls out of the candidates while the predicted impact is further away than ballDt
+template <class Config>
+uint32_t BasicGame<Config>::reachableBallCandidates(int num, physics::scalar ballDt, uint32_t ballCandidates) {
+	if (!(ballCandidates & WALL_PROXY_BITS)) {
+		return ballCandidates;
+	}
+
+	if (!wallImpactValid[num]) {
+		predictWallImpact(num);
+	}
+
+	if (wallImpactTime[num] > ballDt) {
+		++stats.wallPredictionHits;
+		return ballCandidates & ~WALL_PROXY_BITS;
+	}
+
+	++stats.wallPredictionMisses;
+	return ballCandidates;
+}
+
+// Resolves contacts in time of impact order, leaving ballDt with the time the ball still has to travel after the last one
+// Returns the number of contacts resolved
+template <class Config>
+int BasicGame<Config>::resolveBallCollisions(int num, physics::scalar& ballDt, uint32_t ballCandidates) {
+	BallContact contact;
+	int contacts = 0;
+	physics::scalar stepDt = ballDt;
+
+	while (findEarliestBallContact(num, ballDt, reachableBallCandidates(num, ballDt, ballCandidates), contact)) {
+		// Still colliding, e.g. squeezed between a paddle and a wall; holding the ball at its last contact can't tunnel
+		if (contacts == MAX_BALL_CONTACTS_PER_STEP) {
+			++stats.contactLimitHits;
+			ballDt = 0;
+			break;
+		}
+
+		queueCollisionEvent(num, contact, stepStartTime + stepDt - ballDt * (1.0f - contact.timeOfCollision));
+		applyBallContact(num, contact);
+		++contacts;
+
+		ballDt = ballDt * (1.0f - contact.timeOfCollision);
+
+		// The paddle was moved to where it met the ball, so it only has what's left of the step to go
+		if (contact.type == CONTACT_PADDLE && ballDt < paddleDt[contact.index]) {
+			paddleDt[contact.index] = ballDt;
+		}
+		ballCandidates = findBallCandidates(num, ballDt);
+	}
+	return contacts;
+}
+
+// A ball that ends a step sunk into a paddle or wall, or on the far side of a wall from where its last straight run started, got past the solver
+template <class Config>
+bool BasicGame<Config>::ballTunneled(int num, physics::vector2d from) {
+	physics::vector2d to(entities.balls.positionX[num], entities.balls.positionY[num]);
+	physics::scalar radius = entities.balls.extentX[num];
+	physics::Bounds ballBounds = physics::boxBounds(entities.balls.getBox(num));
+
+	for (int i = 0; i < Config::players; ++i) {
+		if (player[i].active && physics::boundsOverlapBy(ballBounds, physics::boxBounds(entities.paddles.getBox(i)), physics::scalar(TUNNELING_TOLERANCE))) {
+			return true;
+		}
+	}
+
+	for (int i = 0; i < NUM_VERTICAL_WALLS; ++i) {
+		const physics::Bounds& wall = verticalWallBounds[i];
+		if (physics::boundsOverlapBy(ballBounds, wall, physics::scalar(TUNNELING_TOLERANCE))) {
+			return true;
+		}
+		if ((from.x < wall.min.x) != (to.x < wall.min.x) && to.y + radius > wall.min.y && to.y - radius < wall.max.y) {
+			return true;
+		}
+	}
+
+	for (int i = 0; i < NUM_HORIZONTAL_WALLS; ++i) {
+		const physics::Bounds& wall = horizontalWallBounds[i];
+		if (physics::boundsOverlapBy(ballBounds, wall, physics::scalar(TUNNELING_TOLERANCE))) {
+			return true;
+		}
+		if ((from.y < wall.min.y) != (to.y < wall.min.y) && to.x + radius > wall.min.x && to.x - radius < wall.max.x) {
+			return true;
+		}
+	}
+
+	// Sweeping the run against the segments, with the ball shrunk by the tolerance, catches both crossing one and ending up in one
+	physics::MovingBox run;
+	run.position = from;
+	run.extents = physics::vector2d(radius - TUNNELING_TOLERANCE, radius - TUNNELING_TOLERANCE);
+	run.velocity = to - from;
+	physics::vector2d position;
+	physics::vector2d normal;
+	physics::scalar timeOfCollision;
+	for (int i = 0; i < Config::segmentWalls && i < settings.numSegmentWalls; ++i) {
+		if (physics::movingBoxCollidesWithSegment(physics::scalar(1), run, segmentWalls[i], position, timeOfCollision, normal)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+template <class Config>
+void BasicGame<Config>::updatePhysics(physics::scalar dt) {
+	// Paddle collision check variables
+	physics::vector2d collisionPositionOfPaddle;
+	physics::scalar timeOfCollision;
+
+	// Only pairs whose swept bounds overlap go through the narrow phase
+	uint32_t ballCandidates[MAX_NUM_BALLS];
+	uint32_t paddleCandidates[MAX_NUM_PLAYERS];
+	updateBroadPhase(dt, ballCandidates, paddleCandidates);
+	
+	for (int i = 0; i < Config::players; ++i) {
+		paddleDt[i] = dt;
+	}
+
+	// A paddle pushing into the floor or ceiling only gets as far as its padded rest against the wall, so slow it to that before the balls are solved against it
+	for (int i = 0; i < Config::players; ++i) {
+		if (player[i].active) {
+			const Paddle* paddle = player[i].getPaddle();
+			for (int j = 0; j < NUM_HORIZONTAL_WALLS; ++j) {
+				if ((paddleCandidates[i] & PROXY_BIT(HORIZONTAL_WALL_PROXY(j))) && physics::movingBoxCollidesWithStatic<physics::STATIC_HORIZONTAL_LINE>(dt, entities.paddles.getBox(i), horizontalWallBounds[j], collisionPositionOfPaddle, timeOfCollision)) {
+					physics::vector2d rest = physics::paddedCollisionPosition(collisionPositionOfPaddle, paddle->getExtents(), horizontalWalls[j].getPosition(), horizontalWalls[j].getExtents());
+					player[i].changeVerticalSpeedTo((rest.y - paddle->getPosition().y) / dt);
+				}
+			}
+		}
+	}
+
+	// Ball collision check and update
+	physics::scalar ballDt[MAX_NUM_BALLS];
+	for (int i = 0; i < settings.numBalls; ++i) {
+		ballDt[i] = 0;
+		if (!pauseBall && ball[i].isActive()) {
+			ballDt[i] = dt;
+			unsigned int iterations = resolveBallCollisions(i, ballDt[i], ballCandidates[i]);
+			stats.collisionIterations += iterations;
+			if (iterations > stats.maxCollisionIterations) {
+				stats.maxCollisionIterations = iterations;
+			}
+		}
+	}
+	// Where each ball's last straight run starts, for the tunneling check
+	physics::vector2d runStart[MAX_NUM_BALLS];
+	for (int i = 0; i < settings.numBalls; ++i) {
+		runStart[i] = ball[i].getPosition();
+	}
+
+	entities.balls.integrate(ballDt, settings.numBalls);
+
+	// Count the predicted wall impacts down by the time each ball travelled
+	for (int i = 0; i < settings.numBalls; ++i) {
+		wallImpactTime[i] -= ballDt[i];
+		if (wallImpactTime[i] <= 0) {
+			wallImpactValid[i] = false;
+		}
+	}
+
+	// Players collision check and update
+	const Paddle* paddle;
+	for (int i = 0; i < Config::players; ++i) {
+		if (player[i].active) {
+			paddle = player[i].getPaddle();
+
+			// Horizontal walls
+			for (int j = 0; j < NUM_HORIZONTAL_WALLS; ++j) {
+				if ((paddleCandidates[i] & PROXY_BIT(HORIZONTAL_WALL_PROXY(j))) && physics::movingBoxCollidesWithStatic<physics::STATIC_HORIZONTAL_LINE>(paddleDt[i], entities.paddles.getBox(i), horizontalWallBounds[j], collisionPositionOfPaddle, timeOfCollision)) {
+
+					// Since collision with the ball can adjust the paddle's position, we want to make sure the paddle doesn't go through the wall
+					player[i].setPosition(physics::paddedCollisionPosition(collisionPositionOfPaddle, paddle->getExtents(), horizontalWalls[j].getPosition(), horizontalWalls[j].getExtents()));
+
+					// Stop the paddle from entering the wall
+					if (collisionPositionOfPaddle.y >= horizontalWalls[j].getPosition().y) {
+						if (player[i].getPaddle()->getVelocity().y < 0) {
+							player[i].changeVerticalSpeedTo(0);
+						}
+					} else {
+						if (player[i].getPaddle()->getVelocity().y > 0) {
+							player[i].changeVerticalSpeedTo(0);
+						}
+					}
+				}
+			}
+
+			// Vertical walls
+			for (int j = 0; j < NUM_VERTICAL_WALLS; ++j) {
+				if ((paddleCandidates[i] & PROXY_BIT(VERTICAL_WALL_PROXY(j))) && physics::movingBoxCollidesWithStatic<physics::STATIC_VERTICAL_LINE>(paddleDt[i], entities.paddles.getBox(i), verticalWallBounds[j], collisionPositionOfPaddle, timeOfCollision)) {
+
+					// Since collision with the ball can adjust the paddle's position, we want to make sure the paddle doesn't go through the wall
+					player[i].setPosition(physics::paddedCollisionPosition(collisionPositionOfPaddle, paddle->getExtents(), verticalWalls[j].getPosition(), verticalWalls[j].getExtents()));
+
+					// Stop the paddle from entering the wall
+					if (collisionPositionOfPaddle.x >= verticalWalls[j].getPosition().x) {
+						if (player[i].getPaddle()->getVelocity().x < 0) {
+							player[i].changeHorizontalSpeedTo(0);
+						}
+					} else {
+						if (player[i].getPaddle()->getVelocity().x > 0) {
+							player[i].changeHorizontalSpeedTo(0);
+						}
+					}
+				}
+			}
+
+			// Update
+			player[i].update(paddleDt[i]);
+		}
+	}
+
+	// Checked once the paddles have moved too, since they can end up on top of a ball as well
+	for (int i = 0; i < settings.numBalls; ++i) {
+		if (ballDt[i] > 0 && ballTunneled(i, runStart[i])) {
+			++stats.tunnelingEvents;
+		}
+	}
+}
+
+template class BasicGame<RuntimeGameConfig>;
+template class BasicGame<ClassicCourtConfig>;
+template class BasicGame<ArenaCourtConfig>;
\ No newline at end of file
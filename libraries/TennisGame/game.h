@@ -1,130 +1,277 @@
-#ifndef GAME_H
-#define GAME_H
-
-#include "ball.h"
-#include "wall.h"
-#include "paddle.h"
-#include "player.h"
-#include "controller.h"
-#include "physics/math2d.h"
-
-#define NUM_HORIZONTAL_WALLS 2
-#define NUM_VERTICAL_WALLS 4
-#define MAX_NUM_PLAYERS 4
-
-struct GameUtility {
-	int screenWidth;
-	int screenHeight;
-	int physicsToPixelRatio;
-
-	float screenToPhysics(float p) const {
-		return p / physicsToPixelRatio;
-	}
-
-	float physicsToScreen(float p) const {
-		return p * physicsToPixelRatio;
-	}
-
-	float physicsToScreenX(float x) const {
-		return physicsToScreen(x);
-	}
-
-	float physicsToScreenY(float y) const {
-		return (screenHeight - 1) - (physicsToScreen(y));
-	}
-};
-
-struct GameSettings {
-	// Bounds
-	physics::vector2d horizontalWallPoints[NUM_HORIZONTAL_WALLS];
-	float horizontalWallLengths[NUM_HORIZONTAL_WALLS];
-	physics::vector2d verticalWallPoints[NUM_VERTICAL_WALLS];
-	float verticalWallLengths[NUM_VERTICAL_WALLS];
-
-	// Ball
-	physics::vector2d ballInitialPoint;
-	float ballDiameter;
-	physics::vector2d ballInitialVelocity;
-	float ballVelocityIncrease;
-	float ballVelocityIncreaseInterval;
-	float maxBallVelocity;
-
-	// Players
-	physics::vector2d playerInitialPoint[MAX_NUM_PLAYERS];
-	float playerLength[MAX_NUM_PLAYERS];
-	float playerHeight[MAX_NUM_PLAYERS];
-	float playerMaxMoveSpeed[MAX_NUM_PLAYERS];
-
-	float speed;
-	float startDelay;
-};
-
-struct GameStats {
-	int leftScore;
-	int rightScore;
-	unsigned int tick;
-};
-
-class Game {
-public:
-	Game(int _screenWidth, int _screenHeight, int _physicsToPixelRatio);
-	void setup(GameSettings _settings);
-	void resetPlayersAndBall();
-	void resetScore();
-	void assignController(int playerNum, PlayerController* _controller);
-	bool winCondition();
-	void tick(float dt);
-	void activatePlayer(int num);
-	void deactivatePlayer(int num);
-	bool playerIsActive(int num);
-	const Player& getPlayer(int num);
-	const GameStats& getStats();
-	const GameUtility& getUtility();
-	void changeStartDelay(float _startDelay);
-	float getStartDelay();
-	bool ballIsPaused();
-	float currentStartTime();
-	void changeBallInitialVelocity(physics::vector2d velocity);
-
-	// For drawing
-	float XpositionOfHorizontalWall(int num);
-	float YpositionOfHorizontalWall(int num);
-	float widthOfHorizontalWall(int num);
-	float XpositionOfVerticalWall(int num);
-	float YpositionOfVerticalWall(int num);
-	float heightOfVerticalWall(int num);
-	float XpositionOfBall();
-	float YpositionOfBall();
-	float diameterOfBall();
-	float XpositionOfPlayer(int num);
-	float YpositionOfPlayer(int num);
-	float widthOfPlayer(int num);
-	float heightOfPlayer(int num);
-	
-	// Callbacks
-	void setBallCollidesWithWall(void (*_ballCollidesWithWall)());
-	void setBallCollidesWithPaddle(void (*_ballCollidesWithPaddle)());
-	
-private:
-	void updatePlayers();
-	void updatePhysics(float dt);
-
-	GameUtility utility;
-	GameSettings settings;
-	GameStats stats;
-	Ball ball;
-	HorizontalWall horizontalWalls[NUM_HORIZONTAL_WALLS];
-	VerticalWall verticalWalls[NUM_VERTICAL_WALLS];
-	Paddle paddles[MAX_NUM_PLAYERS];
-	Player player[MAX_NUM_PLAYERS];
-	PlayerController* controller[MAX_NUM_PLAYERS];
-	
-	float startTimer;
-	float ballVelocityIncreaseTimer;
-	bool pauseBall;
-	
-	void (*ballCollidesWithWall)();
-	void (*ballCollidesWithPaddle)();
-};
-
+#ifndef GAME_H
+#define GAME_H
+
+#include "ball.h"
+#include "wall.h"
+#include "paddle.h"
+#include "player.h"
+#include "controller.h"
+#include "broadphase.h"
+#include "sweepbatch.h"
+#include "ringbuffer.h"
+#include "prng.h"
+#include "gameconfig.h"
+#include "physics/math2d.h"
+
+// Walls, paddles and balls each have a broad phase proxy; candidates are kept as 32-bit masks of proxies
+#define NUM_BROAD_PHASE_PROXIES (NUM_HORIZONTAL_WALLS + NUM_VERTICAL_WALLS + MAX_SEGMENT_WALLS + MAX_NUM_PLAYERS + MAX_NUM_BALLS)
+#define MAX_BROAD_PHASE_PAIRS ((MAX_NUM_PLAYERS + MAX_NUM_BALLS) * (NUM_HORIZONTAL_WALLS + NUM_VERTICAL_WALLS) + MAX_NUM_BALLS * (MAX_SEGMENT_WALLS + MAX_NUM_PLAYERS))
+
+// Most contacts one ball resolves in a physics step; a ball still colliding after that waits at its last contact until the next step,
+// so a tick allows up to this times MAX_PHYSICS_SUBSTEPS
+#define MAX_BALL_CONTACTS_PER_STEP 8
+
+// Physics steps a tick may be split into, so nothing moves further than the smallest collider in one step
+#define MAX_PHYSICS_SUBSTEPS 8
+
+// How deep (in units) a ball may sink into a paddle or wall before it counts as having tunneled
+#define TUNNELING_TOLERANCE 0.015625f
+
+// How far ahead (in seconds) a ball's next wall impact is predicted, and the margin (in units) the prediction adds around the ball
+#define WALL_PREDICTION_HORIZON 1.0f
+#define WALL_PREDICTION_SKIN 0.0625f
+
+// Steepest slope a ball leaves a paddle's side at, reached by a hit on the very end and never passed whatever the paddle's speed,
+// and how much slope the paddle's vertical speed adds per unit of the ball's speed
+#define PADDLE_REBOUND_MAX_SLOPE 1.5f
+#define PADDLE_REBOUND_SPIN 0.25f
+
+// Velocities are scaled by this while working out a rebound, so that in Q16.16 their squares can't overflow
+#define PADDLE_REBOUND_VELOCITY_SCALE 0.0625f
+
+// advance() runs physics in fixed steps of 1 / PHYSICS_STEP_RATE seconds, however often the game is drawn
+#define PHYSICS_STEP_RATE 240
+
+// Most steps one advance() catches up on; real time beyond that is dropped, so a long stall slows the game instead of stalling it further
+#define MAX_PHYSICS_STEPS_PER_ADVANCE 12
+
+// Collision events kept until they're read, a power of two; more than this between reads and the newest are dropped
+#define COLLISION_EVENT_QUEUE_SIZE 32
+
+class InputRecorder;
+
+struct GameStats {
+	int leftScore;
+	int rightScore;
+	unsigned int tick;
+
+	// Physics steps the last tick was split into
+	unsigned int substeps;
+
+	// Contacts the ball solver resolved last tick over all balls and steps, and the most any one ball has needed in a step
+	unsigned int collisionIterations;
+	unsigned int maxCollisionIterations;
+
+	// Times a ball hit MAX_BALL_CONTACTS_PER_STEP in a step and was held for the rest of it, and balls found inside or past a collider after a step
+	unsigned int contactLimitHits;
+	unsigned int tunnelingEvents;
+
+	// Times the ball solver left the walls out because the predicted wall impact was further away than the step, and times it had to test them
+	unsigned int wallPredictionHits;
+	unsigned int wallPredictionMisses;
+
+	// Collision events that didn't fit in the queue because nobody read it in time
+	unsigned int droppedCollisionEvents;
+};
+
+enum BallContactType {
+	CONTACT_PADDLE,
+	CONTACT_VERTICAL_WALL,
+	CONTACT_HORIZONTAL_WALL,
+	CONTACT_SEGMENT_WALL
+};
+
+// One contact found by the ball solver; index is the player or wall number
+struct BallContact {
+	BallContactType type;
+	int index;
+	physics::scalar timeOfCollision;
+	physics::vector2d positionOfBall;
+	physics::vector2d positionOfPaddle;
+
+	// Segment walls only: the unit normal the ball is pushed along
+	physics::vector2d normal;
+};
+
+// A ball hitting something, queued by tick() for sound, effects and the like to read once the tick is done
+struct CollisionEvent {
+	BallContactType type;
+	int ball;
+
+	// Player or wall number
+	int index;
+
+	// Where the ball's centre was at impact
+	physics::vector2d position;
+
+	// How fast the ball was closing in on what it hit, along the direction it gets pushed
+	physics::scalar relativeSpeed;
+
+	// Physics time into the tick the ball hit, and which tick
+	physics::scalar timeOfImpact;
+	unsigned int tick;
+};
+
+// Everything a tick changes, without pointers, so it can be copied freely and restored into any Game set up with the same settings
+// Render blending, the time advance() is owed and queued collision events are left out
+struct GameSnapshot {
+	EntityStore entities;
+	bool playerActive[MAX_NUM_PLAYERS];
+	GameStats stats;
+
+	// Settings that can change between rounds
+	int numBalls;
+	physics::vector2d ballInitialVelocity;
+	physics::scalar startDelay;
+
+	physics::scalar wallImpactTime[MAX_NUM_BALLS];
+	bool wallImpactValid[MAX_NUM_BALLS];
+	physics::scalar startTimer;
+	physics::scalar ballVelocityIncreaseTimer;
+	bool pauseBall;
+	uint32_t randomState;
+};
+
+// Config is a configuration policy from gameconfig.h; what it fixes is folded into the code, everything else comes from setup()
+template <class Config>
+class BasicGame {
+public:
+	BasicGame(int _screenWidth, int _screenHeight, int _physicsToPixelRatio);
+
+	// For configurations with a fixed screen
+	BasicGame();
+
+	void setup(GameSettings _settings);
+	void resetPlayersAndBall();
+	void resetScore();
+	void assignController(int playerNum, PlayerController* _controller);
+	bool winCondition();
+	void tick(float dt);
+	int advance(float realDt);
+	float interpolation();
+	void activatePlayer(int num);
+	void deactivatePlayer(int num);
+	bool playerIsActive(int num);
+	const Player& getPlayer(int num);
+	const Ball& getBall(int num);
+	const GameStats& getStats();
+	const typename Config::Utility& getUtility();
+	void changeStartDelay(float _startDelay);
+	float getStartDelay();
+	bool ballIsPaused();
+	float currentStartTime();
+	void changeBallInitialVelocity(physics::vector2d velocity);
+	void changeNumberOfBalls(int num);
+	int numberOfBalls();
+	bool ballIsActive(int num);
+
+	// For drawing; balls and players are placed between the last two physics steps when driven by advance()
+	float XpositionOfHorizontalWall(int num);
+	float YpositionOfHorizontalWall(int num);
+	float widthOfHorizontalWall(int num);
+	float XpositionOfVerticalWall(int num);
+	float YpositionOfVerticalWall(int num);
+	float heightOfVerticalWall(int num);
+	int numberOfSegmentWalls();
+	float XstartOfSegmentWall(int num);
+	float YstartOfSegmentWall(int num);
+	float XendOfSegmentWall(int num);
+	float YendOfSegmentWall(int num);
+	float XpositionOfBall(int num = 0);
+	float YpositionOfBall(int num = 0);
+	float diameterOfBall(int num = 0);
+	float XpositionOfPlayer(int num);
+	float YpositionOfPlayer(int num);
+	float widthOfPlayer(int num);
+	float heightOfPlayer(int num);
+
+	// Collisions since the last call, oldest first; returns false once they've all been read
+	bool nextCollisionEvent(CollisionEvent& event);
+
+	// Copies the game's state out or back in, e.g. for rollback or to start a round over instantly
+	void save(GameSnapshot& snapshot) const;
+	void restore(const GameSnapshot& snapshot);
+
+	// Ball take-off directions come from the game's own generator, so the same seed and inputs play the same match
+	void seed(uint32_t seed);
+
+	// Logs every tick's controller input and state hash, with a keyframe whenever the game was changed between ticks; 0 stops
+	void record(InputRecorder* _recorder);
+
+	// Hash of everything a snapshot holds, for checking a replay or a remote game against this one
+	uint32_t stateHash();
+	
+private:
+	void init();
+	void updatePlayers();
+	void savePreviousPositions();
+	physics::vector2d interpolatedPosition(physics::vector2d previous, physics::vector2d current);
+	int physicsSubsteps(physics::scalar dt);
+	void updatePhysics(physics::scalar dt);
+	void updateBroadPhase(physics::scalar dt, uint32_t* ballCandidates, uint32_t* paddleCandidates);
+	uint32_t findBallCandidates(int num, physics::scalar dt);
+	bool wallPushesAlongX(int num, const BallContact& contact, physics::vector2d& wallToBall);
+	physics::scalar closingSpeed(int num, const BallContact& contact);
+	bool ballApproaches(int num, const BallContact& contact);
+	bool findEarliestWallContact(int num, const physics::MovingBox& ballObject, physics::scalar dt, uint32_t walls, BallContact& contact);
+	bool findEarliestBallContact(int num, physics::scalar ballDt, uint32_t ballCandidates, BallContact& contact);
+	void applyBallContact(int num, const BallContact& contact);
+	void queueCollisionEvent(int num, const BallContact& contact, physics::scalar timeOfImpact);
+	void bounceBallOffPaddle(int num, int playerNum, const BallContact& contact);
+	void reboundOffPaddleSide(int num, const Paddle* paddle, physics::vector2d paddleToBall);
+	void predictWallImpact(int num);
+	uint32_t reachableBallCandidates(int num, physics::scalar ballDt, uint32_t ballCandidates);
+	int resolveBallCollisions(int num, physics::scalar& ballDt, uint32_t ballCandidates);
+	bool ballTunneled(int num, physics::vector2d from);
+
+	typename Config::Utility utility;
+	GameSettings settings;
+	GameStats stats;
+	EntityStore entities;
+	Ball ball[MAX_NUM_BALLS];
+	HorizontalWall horizontalWalls[NUM_HORIZONTAL_WALLS];
+	VerticalWall verticalWalls[NUM_VERTICAL_WALLS];
+	physics::Bounds horizontalWallBounds[NUM_HORIZONTAL_WALLS];
+	physics::Bounds verticalWallBounds[NUM_VERTICAL_WALLS];
+	physics::Segment segmentWalls[MAX_SEGMENT_WALLS];
+	physics::BasicSweepTargets<physics::scalar, NUM_HORIZONTAL_WALLS + NUM_VERTICAL_WALLS> wallTargets;
+	Paddle paddles[MAX_NUM_PLAYERS];
+	Player player[MAX_NUM_PLAYERS];
+	PlayerController* controller[MAX_NUM_PLAYERS];
+	physics::BasicSortAndSweep<physics::scalar, NUM_BROAD_PHASE_PROXIES> broadPhase;
+
+	// Time each paddle still has to move this step; a ball contact moves it partway
+	physics::scalar paddleDt[MAX_NUM_PLAYERS];
+
+	// Time left until each ball's predicted wall impact, until a contact or velocity change invalidates it
+	physics::scalar wallImpactTime[MAX_NUM_BALLS];
+	bool wallImpactValid[MAX_NUM_BALLS];
+	
+	// 1 / the smallest ball, paddle or wall stub dimension, for picking the number of substeps
+	physics::scalar inverseMinColliderSize;
+
+	// Real time advance() has not simulated yet, always less than a step, and how far the drawn positions are from the previous step to the last one
+	float accumulator;
+	physics::scalar renderAlpha;
+	physics::vector2d previousBallPosition[MAX_NUM_BALLS];
+	physics::vector2d previousPaddlePosition[MAX_NUM_PLAYERS];
+
+	// How far into the tick the current physics step starts
+	physics::scalar stepStartTime;
+
+	physics::scalar startTimer;
+	physics::scalar ballVelocityIncreaseTimer;
+	bool pauseBall;
+	Prng prng;
+
+	// Set by anything that changes the game outside tick(), so the recorder knows to write a keyframe
+	InputRecorder* recorder;
+	bool keyframeNeeded;
+
+	RingBuffer<CollisionEvent, COLLISION_EVENT_QUEUE_SIZE> collisionEvents;
+};
+
+// Set up at run time from GameSettings, as the host tools use it
+typedef BasicGame<RuntimeGameConfig> Game;
+
 #endif
\ No newline at end of file
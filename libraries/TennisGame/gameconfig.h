@@ -0,0 +1,163 @@
+#ifndef GAMECONFIG_H
+#define GAMECONFIG_H
+
+#include "entities.h"
+#include "physics/math2d.h"
+
+#define NUM_HORIZONTAL_WALLS 2
+#define NUM_VERTICAL_WALLS 4
+#define MAX_SEGMENT_WALLS 8
+
+struct GameUtility {
+	int screenWidth;
+	int screenHeight;
+	int physicsToPixelRatio;
+
+	float screenToPhysics(float p) const {
+		return p / physicsToPixelRatio;
+	}
+
+	float physicsToScreen(float p) const {
+		return p * physicsToPixelRatio;
+	}
+
+	float physicsToScreenX(float x) const {
+		return physicsToScreen(x);
+	}
+
+	float physicsToScreenY(float y) const {
+		return (screenHeight - 1) - (physicsToScreen(y));
+	}
+};
+
+// GameUtility with the screen fixed at compile time, so every conversion folds down to constants
+template <int ScreenWidth, int ScreenHeight, int PhysicsToPixelRatio>
+struct FixedGameUtility {
+	static const int screenWidth = ScreenWidth;
+	static const int screenHeight = ScreenHeight;
+	static const int physicsToPixelRatio = PhysicsToPixelRatio;
+
+	static float screenToPhysics(float p) {
+		return p / (float)PhysicsToPixelRatio;
+	}
+
+	static float physicsToScreen(float p) {
+		return p * (float)PhysicsToPixelRatio;
+	}
+
+	static float physicsToScreenX(float x) {
+		return physicsToScreen(x);
+	}
+
+	static float physicsToScreenY(float y) {
+		return (ScreenHeight - 1) - physicsToScreen(y);
+	}
+};
+
+inline void setupUtility(GameUtility& utility, int screenWidth, int screenHeight, int physicsToPixelRatio) {
+	utility.screenWidth = screenWidth;
+	utility.screenHeight = screenHeight;
+	utility.physicsToPixelRatio = physicsToPixelRatio;
+}
+
+// A fixed screen can't be changed; what's passed in is ignored
+template <int ScreenWidth, int ScreenHeight, int PhysicsToPixelRatio>
+inline void setupUtility(FixedGameUtility<ScreenWidth, ScreenHeight, PhysicsToPixelRatio>& utility, int screenWidth, int screenHeight, int physicsToPixelRatio) {
+}
+
+struct GameSettings {
+	// Bounds
+	physics::vector2d horizontalWallPoints[NUM_HORIZONTAL_WALLS];
+	physics::scalar horizontalWallLengths[NUM_HORIZONTAL_WALLS];
+	physics::vector2d verticalWallPoints[NUM_VERTICAL_WALLS];
+	physics::scalar verticalWallLengths[NUM_VERTICAL_WALLS];
+
+	// Extra walls at any angle, e.g. bumpers in the middle of the field; only balls collide with these
+	int numSegmentWalls;
+	physics::vector2d segmentWallStarts[MAX_SEGMENT_WALLS];
+	physics::vector2d segmentWallEnds[MAX_SEGMENT_WALLS];
+
+	// Ball
+	int numBalls;
+	physics::vector2d ballInitialPoint;
+	physics::scalar ballDiameter;
+	physics::vector2d ballInitialVelocity;
+	physics::scalar ballVelocityIncrease;
+	physics::scalar ballVelocityIncreaseInterval;
+	physics::scalar maxBallVelocity;
+
+	// Players
+	physics::vector2d playerInitialPoint[MAX_NUM_PLAYERS];
+	physics::scalar playerLength[MAX_NUM_PLAYERS];
+	physics::scalar playerHeight[MAX_NUM_PLAYERS];
+	physics::scalar playerMaxMoveSpeed[MAX_NUM_PLAYERS];
+
+	physics::scalar speed;
+	physics::scalar startDelay;
+};
+
+// A game's configuration policy says what's fixed when it's compiled:
+//   Utility        GameUtility, or a FixedGameUtility for a screen known up front
+//   players        player slots that can play; the rest stay inactive and are never updated or checked
+//   balls          most balls the game can have in play
+//   segmentWalls   most segment walls; 0 takes the segment wall code out altogether
+//   applyCourt()   writes any walls the configuration fixes over the ones in GameSettings
+// Add a configuration to the explicit instantiations at the end of game.cpp (and interceptcontroller.cpp) to use it
+
+// Everything comes from GameSettings and the constructor, as the host tools want it
+struct RuntimeGameConfig {
+	typedef GameUtility Utility;
+	static const int players = MAX_NUM_PLAYERS;
+	static const int balls = MAX_NUM_BALLS;
+	static const int segmentWalls = MAX_SEGMENT_WALLS;
+
+	static void applyCourt(GameSettings& settings) {
+	}
+};
+
+// The sketch's 56 x 24 LED court: floor and ceiling the whole width, a short wall stub either side of each goal,
+// up to four players and the multi-ball count of balls, and no segment walls
+struct ClassicCourtConfig {
+	typedef FixedGameUtility<56, 24, 1> Utility;
+	static const int players = 4;
+	static const int balls = 8;
+	static const int segmentWalls = 0;
+
+	static const int wallLength = 55;
+	static const int wallStubHeight = 3;
+
+	static void applyCourt(GameSettings& settings) {
+		const int top = Utility::screenHeight - 1;
+
+		// Floor and ceiling
+		settings.horizontalWallPoints[0] = physics::vector2d(0, 0);
+		settings.horizontalWallPoints[1] = physics::vector2d(0, top);
+
+		// Bottom left, top left, bottom right and top right stubs
+		settings.verticalWallPoints[0] = physics::vector2d(0, 0);
+		settings.verticalWallPoints[1] = physics::vector2d(0, top - wallStubHeight);
+		settings.verticalWallPoints[2] = physics::vector2d(wallLength, 0);
+		settings.verticalWallPoints[3] = physics::vector2d(wallLength, top - wallStubHeight);
+
+		for (int i = 0; i < NUM_HORIZONTAL_WALLS; ++i) {
+			settings.horizontalWallLengths[i] = wallLength;
+		}
+		for (int i = 0; i < NUM_VERTICAL_WALLS; ++i) {
+			settings.verticalWallLengths[i] = wallStubHeight;
+		}
+		settings.numSegmentWalls = 0;
+	}
+};
+
+// The sketch's screen and counts with the walls left to GameSettings, for courts loaded from an arena
+struct ArenaCourtConfig {
+	typedef ClassicCourtConfig::Utility Utility;
+	static const int players = ClassicCourtConfig::players;
+	static const int balls = ClassicCourtConfig::balls;
+	static const int segmentWalls = MAX_SEGMENT_WALLS;
+
+	static void applyCourt(GameSettings& settings) {
+	}
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,35 @@
+#include "inputevents.h"
+
+ButtonDebouncer::ButtonDebouncer(unsigned long _debounceTime) : debounceTime(_debounceTime), pressed(false), lastDown(false), seenEdge(false), lastEdge(0), bounceStart(0) {
+}
+
+ButtonEvent ButtonDebouncer::settleAt(unsigned long time) {
+	ButtonEvent event = {BUTTON_NONE, bounceStart};
+	if (lastDown != pressed && (long)(time - lastEdge) >= (long)debounceTime) {
+		pressed = lastDown;
+		event.type = pressed ? BUTTON_PRESSED : BUTTON_RELEASED;
+	}
+	return event;
+}
+
+ButtonEvent ButtonDebouncer::edge(const InputEdge& edge) {
+	// The level before this edge may have held long enough to count
+	ButtonEvent event = settleAt(edge.time);
+
+	// An edge after a quiet spell starts a new bounce; one inside it carries the bounce on
+	if (!seenEdge || edge.time - lastEdge >= debounceTime) {
+		bounceStart = edge.time;
+	}
+	seenEdge = true;
+	lastEdge = edge.time;
+	lastDown = edge.down;
+	return event;
+}
+
+ButtonEvent ButtonDebouncer::settle(unsigned long now) {
+	return settleAt(now);
+}
+
+bool ButtonDebouncer::isPressed() const {
+	return pressed;
+}
\ No newline at end of file
@@ -0,0 +1,85 @@
+#ifndef INPUTEVENTS_H
+#define INPUTEVENTS_H
+
+#include <stdint.h>
+#include "ringbuffer.h"
+
+// Edges one interrupt handler can get ahead of the loop by; must be a power of two
+#define INPUT_EDGE_QUEUE_SIZE 32
+
+// A button's level has to hold this long, in microseconds, before it counts
+#define BUTTON_DEBOUNCE_TIME 10000
+
+// A pin changing level, as its interrupt handler saw it
+struct InputEdge {
+	unsigned long time;
+	uint8_t source;
+	bool down;
+};
+
+// Carries edges from one interrupt handler to the loop without either side turning interrupts off.
+// A RingBuffer underneath, so it takes exactly one producer: give each handler a queue of its own.
+class InputEdgeQueue {
+public:
+	InputEdgeQueue() : dropped(0) {}
+
+	// Interrupt side; an edge that doesn't fit is counted rather than waited for
+	void push(uint8_t source, bool down, unsigned long time) {
+		InputEdge edge = {time, source, down};
+		if (!edges.push(edge)) {
+			dropped = dropped + 1;
+		}
+	}
+
+	// Loop side
+	bool pop(InputEdge& edge) {
+		return edges.pop(edge);
+	}
+
+	// Only the interrupt side writes this
+	volatile unsigned long dropped;
+
+private:
+	RingBuffer<InputEdge, INPUT_EDGE_QUEUE_SIZE> edges;
+};
+
+enum ButtonEventType {
+	BUTTON_NONE,
+	BUTTON_PRESSED,
+	BUTTON_RELEASED
+};
+
+struct ButtonEvent {
+	ButtonEventType type;
+
+	// When the bounce that ended in this press or release started
+	unsigned long time;
+};
+
+// Turns one button's raw edges into presses and releases, on the loop side.
+// A level counts once it has held for the debounce time, either until the next edge or until now, so bounces and
+// glitches shorter than that never get through; the event keeps the time of the first edge of its bounce.
+class ButtonDebouncer {
+public:
+	ButtonDebouncer(unsigned long _debounceTime = BUTTON_DEBOUNCE_TIME);
+
+	// Feeds one edge, in the order they happened
+	ButtonEvent edge(const InputEdge& edge);
+
+	// Counts the last edge's level once it's held until now; read now before taking the edges, so none from before it is still queued
+	ButtonEvent settle(unsigned long now);
+
+	bool isPressed() const;
+
+private:
+	ButtonEvent settleAt(unsigned long time);
+
+	unsigned long debounceTime;
+	bool pressed;
+	bool lastDown;
+	bool seenEdge;
+	unsigned long lastEdge;
+	unsigned long bounceStart;
+};
+
+#endif
\ No newline at end of file
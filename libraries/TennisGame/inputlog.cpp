@@ -0,0 +1,193 @@
+#include "inputlog.h"
+#include <string.h>
+
+#ifdef PHYSICS_FIXED_POINT
+#define INPUT_LOG_FIXED_POINT 1
+#else
+#define INPUT_LOG_FIXED_POINT 0
+#endif
+
+// FNV-1a step on the whole word
+uint32_t rollStateHash(uint32_t rolling, uint32_t stateHash) {
+	return (rolling ^ stateHash) * 16777619u;
+}
+
+InputRecorder::InputRecorder(InputLogWriter* _writer) : writer(_writer), stepSize(0), rollingHash(2166136261u) {
+	for (int i = 0; i < MAX_NUM_PLAYERS; ++i) {
+		speeds[i] = 0;
+	}
+}
+
+template <typename T>
+void InputRecorder::write(const T& value) {
+	writer->write(&value, sizeof(value));
+}
+
+void InputRecorder::begin(const GameUtility& utility, const GameSettings& settings) {
+	write<uint32_t>(INPUT_LOG_MAGIC);
+	write<uint16_t>(INPUT_LOG_VERSION);
+	write<uint8_t>(INPUT_LOG_FIXED_POINT);
+	write<uint8_t>(MAX_NUM_PLAYERS);
+	write<uint16_t>(sizeof(GameSettings));
+	write<uint16_t>(sizeof(GameSnapshot));
+	write<int16_t>(utility.screenWidth);
+	write<int16_t>(utility.screenHeight);
+	write<int16_t>(utility.physicsToPixelRatio);
+	write(settings);
+
+	// Every speed and the step size go out in full after this
+	stepSize = 0;
+	for (int i = 0; i < MAX_NUM_PLAYERS; ++i) {
+		speeds[i] = 0;
+	}
+}
+
+void InputRecorder::keyframe(uint8_t controlled, const GameSnapshot& snapshot) {
+	write<uint8_t>(INPUT_LOG_KEYFRAME);
+	write(controlled);
+	write(snapshot);
+	rollingHash = 2166136261u;
+}
+
+void InputRecorder::tick(float dt, const float* _speeds, uint32_t stateHash) {
+	if (dt != stepSize) {
+		stepSize = dt;
+		write<uint8_t>(INPUT_LOG_STEP_SIZE);
+		write(dt);
+	}
+
+	uint8_t changed = 0;
+	for (int i = 0; i < MAX_NUM_PLAYERS; ++i) {
+		if (_speeds[i] != speeds[i]) {
+			changed |= 1 << i;
+		}
+	}
+
+	write<uint8_t>(INPUT_LOG_TICK);
+	write(changed);
+	for (int i = 0; i < MAX_NUM_PLAYERS; ++i) {
+		if (changed & (1 << i)) {
+			speeds[i] = _speeds[i];
+			write(speeds[i]);
+		}
+	}
+
+	rollingHash = rollStateHash(rollingHash, stateHash);
+	write(rollingHash);
+}
+
+void InputRecorder::button(uint8_t id) {
+	write<uint8_t>(INPUT_LOG_BUTTON);
+	write(id);
+}
+
+InputReplay::InputReplay(const uint8_t* _data, int _size) : ticks(0), desyncTick(0), buttons(0), data(_data), size(_size), offset(0), stepSize(0), rollingHash(2166136261u) {
+}
+
+template <typename T>
+bool InputReplay::read(T& value) {
+	if (offset + (int)sizeof(value) > size) {
+		return false;
+	}
+	memcpy(&value, data + offset, sizeof(value));
+	offset += sizeof(value);
+	return true;
+}
+
+bool InputReplay::begin(GameUtility& utility, GameSettings& settings) {
+	uint32_t magic;
+	uint16_t version;
+	uint8_t fixedPoint;
+	uint8_t maxPlayers;
+	uint16_t settingsSize;
+	uint16_t snapshotSize;
+	int16_t screenWidth;
+	int16_t screenHeight;
+	int16_t physicsToPixelRatio;
+
+	offset = 0;
+	if (!read(magic) || !read(version) || !read(fixedPoint) || !read(maxPlayers) || !read(settingsSize) || !read(snapshotSize)) {
+		return false;
+	}
+	if (magic != INPUT_LOG_MAGIC || version != INPUT_LOG_VERSION || fixedPoint != INPUT_LOG_FIXED_POINT || maxPlayers != MAX_NUM_PLAYERS || settingsSize != sizeof(GameSettings) || snapshotSize != sizeof(GameSnapshot)) {
+		return false;
+	}
+	if (!read(screenWidth) || !read(screenHeight) || !read(physicsToPixelRatio) || !read(settings)) {
+		return false;
+	}
+
+	utility.screenWidth = screenWidth;
+	utility.screenHeight = screenHeight;
+	utility.physicsToPixelRatio = physicsToPixelRatio;
+	return true;
+}
+
+InputReplayResult InputReplay::step(Game& game) {
+	uint8_t type;
+	while (read(type)) {
+		switch (type) {
+			case INPUT_LOG_STEP_SIZE:
+				if (!read(stepSize)) {
+					return REPLAY_CORRUPT;
+				}
+				break;
+
+			case INPUT_LOG_KEYFRAME: {
+				uint8_t controlled;
+				GameSnapshot snapshot;
+				if (!read(controlled) || !read(snapshot)) {
+					return REPLAY_CORRUPT;
+				}
+				for (int i = 0; i < MAX_NUM_PLAYERS; ++i) {
+					game.assignController(i, (controlled & (1 << i)) ? &controller[i] : 0);
+				}
+				game.restore(snapshot);
+				rollingHash = 2166136261u;
+				break;
+			}
+
+			case INPUT_LOG_TICK: {
+				uint8_t changed;
+				uint32_t expectedHash;
+				if (!read(changed)) {
+					return REPLAY_CORRUPT;
+				}
+				for (int i = 0; i < MAX_NUM_PLAYERS; ++i) {
+					float speed;
+					if (changed & (1 << i)) {
+						if (!read(speed)) {
+							return REPLAY_CORRUPT;
+						}
+						controller[i].setSpeed(speed);
+					}
+				}
+				if (!read(expectedHash)) {
+					return REPLAY_CORRUPT;
+				}
+
+				game.tick(stepSize);
+				++ticks;
+
+				rollingHash = rollStateHash(rollingHash, game.stateHash());
+				if (rollingHash != expectedHash) {
+					desyncTick = game.getStats().tick;
+					return REPLAY_DESYNC;
+				}
+				return REPLAY_TICKED;
+			}
+
+			case INPUT_LOG_BUTTON: {
+				uint8_t id;
+				if (!read(id)) {
+					return REPLAY_CORRUPT;
+				}
+				++buttons;
+				break;
+			}
+
+			default:
+				return REPLAY_CORRUPT;
+		}
+	}
+	return offset == size ? REPLAY_FINISHED : REPLAY_CORRUPT;
+}
\ No newline at end of file
@@ -0,0 +1,91 @@
+#ifndef INPUTLOG_H
+#define INPUTLOG_H
+
+#include <stdint.h>
+#include "game.h"
+
+// A log is a header followed by records, each starting with its type byte
+// Values are written in the machine's own byte order and snapshots as raw bytes, so a log only replays on a build with the same physics scalar; the header says which
+#define INPUT_LOG_MAGIC 0x4C525454u
+#define INPUT_LOG_VERSION 1
+
+enum InputLogRecordType {
+	// Step size (float) for the ticks that follow
+	INPUT_LOG_STEP_SIZE = 1,
+
+	// Which players have controllers (uint8_t mask), then a GameSnapshot of the game as it was before the next tick
+	INPUT_LOG_KEYFRAME = 2,
+
+	// Mask of players whose controller speed changed (uint8_t), their new speeds (float each), then the rolling state hash after the tick (uint32_t)
+	INPUT_LOG_TICK = 3,
+
+	// A button press (uint8_t id); what it does to the game shows up in the next keyframe
+	INPUT_LOG_BUTTON = 4
+};
+
+// Where the log's bytes go, e.g. a file on a PC or the USB serial port on the Teensy
+class InputLogWriter {
+public:
+	virtual void write(const void* data, int size) = 0;
+};
+
+// Folds one tick's state hash into the hash of every tick since the last keyframe
+uint32_t rollStateHash(uint32_t rolling, uint32_t stateHash);
+
+// Writes the log as the game runs; a game given this by Game::record() calls it every tick
+class InputRecorder {
+public:
+	InputRecorder(InputLogWriter* _writer);
+	void begin(const GameUtility& utility, const GameSettings& settings);
+	void keyframe(uint8_t controlled, const GameSnapshot& snapshot);
+	void tick(float dt, const float* speeds, uint32_t stateHash);
+	void button(uint8_t id);
+
+private:
+	template <typename T>
+	void write(const T& value);
+
+	InputLogWriter* writer;
+	float stepSize;
+	float speeds[MAX_NUM_PLAYERS];
+	uint32_t rollingHash;
+};
+
+enum InputReplayResult {
+	REPLAY_TICKED,
+	REPLAY_FINISHED,
+	REPLAY_DESYNC,
+	REPLAY_CORRUPT
+};
+
+// Plays a log held in memory back into a game, as fast as it's stepped, checking the state hash after every tick
+class InputReplay {
+public:
+	InputReplay(const uint8_t* _data, int _size);
+
+	// Reads the header; fails if it isn't a log or was recorded with a different physics scalar or version
+	bool begin(GameUtility& utility, GameSettings& settings);
+
+	// Applies records up to and including the next tick; keyframes hand the game the replay's own controllers
+	InputReplayResult step(Game& game);
+
+	// Ticks replayed so far, and the game's own tick count when a desync was found
+	unsigned int ticks;
+	unsigned int desyncTick;
+
+	// Button presses seen so far
+	unsigned int buttons;
+
+private:
+	template <typename T>
+	bool read(T& value);
+
+	const uint8_t* data;
+	int size;
+	int offset;
+	float stepSize;
+	uint32_t rollingHash;
+	PlayerController controller[MAX_NUM_PLAYERS];
+};
+
+#endif
\ No newline at end of file
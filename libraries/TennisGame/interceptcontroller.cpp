@@ -0,0 +1,124 @@
+#include "interceptcontroller.h"
+#include "game.h"
+#include <math.h>
+
+template <class Config>
+BasicInterceptController<Config>::BasicInterceptController() : game(0), playerNum(0), reactionDelay(INTERCEPT_REACTION_DELAY), aimError(INTERCEPT_AIM_ERROR), gain(INTERCEPT_GAIN), sinceLook(0), target(0), error(0), approaching(false) {
+}
+
+template <class Config>
+void BasicInterceptController<Config>::bind(BasicGame<Config>* _game, int _playerNum) {
+	game = _game;
+	playerNum = _playerNum;
+
+	// Looks on the first update
+	sinceLook = reactionDelay;
+	approaching = false;
+}
+
+template <class Config>
+void BasicInterceptController<Config>::seed(uint32_t seed) {
+	random.setSeed(seed);
+}
+
+template <class Config>
+void BasicInterceptController<Config>::setReactionDelay(float _reactionDelay) {
+	reactionDelay = _reactionDelay;
+}
+
+template <class Config>
+void BasicInterceptController<Config>::setAimError(float _aimError) {
+	aimError = _aimError;
+}
+
+template <class Config>
+void BasicInterceptController<Config>::setGain(float _gain) {
+	gain = _gain;
+}
+
+template <class Config>
+float BasicInterceptController<Config>::getTarget() const {
+	return target;
+}
+
+template <class Config>
+void BasicInterceptController<Config>::update(float dt) {
+	const Paddle* paddle = game->getPlayer(playerNum).getPaddle();
+
+	sinceLook += dt;
+	if (sinceLook >= reactionDelay) {
+		sinceLook = 0;
+
+		float y;
+		bool nowApproaching = findIntercept(y);
+		if (nowApproaching && !approaching) {
+			error = aimError * ((int)random.below(2001) - 1000) / 1000.0f;
+		}
+		approaching = nowApproaching;
+
+		// With nothing coming, wait in the middle
+		target = approaching ? y + error : (game->YpositionOfHorizontalWall(0) + game->YpositionOfHorizontalWall(1)) * 0.5f;
+	}
+
+	setSpeed((target - physics::toFloat(paddle->getPosition().y)) * gain);
+}
+
+// Height of the first ball to reach the paddle's face, when one is headed for it
+template <class Config>
+bool BasicInterceptController<Config>::findIntercept(float& y) {
+	const Paddle* paddle = game->getPlayer(playerNum).getPaddle();
+	float paddleX = physics::toFloat(paddle->getPosition().x);
+	float paddleExtentX = physics::toFloat(paddle->getExtents().x);
+	float floor = game->YpositionOfHorizontalWall(0);
+	float ceiling = game->YpositionOfHorizontalWall(1);
+	if (floor > ceiling) {
+		float swap = floor;
+		floor = ceiling;
+		ceiling = swap;
+	}
+
+	bool found = false;
+	float earliest = 0;
+	for (int i = 0; i < game->numberOfBalls(); ++i) {
+		if (!game->ballIsActive(i)) {
+			continue;
+		}
+		const Ball& ball = game->getBall(i);
+		float ballX = physics::toFloat(ball.getPosition().x);
+		float ballY = physics::toFloat(ball.getPosition().y);
+		float velocityX = physics::toFloat(ball.getVelocityX());
+		float velocityY = physics::toFloat(ball.getVelocityY());
+		float radius = physics::toFloat(ball.getRadius());
+
+		// The face on the ball's side; a ball moving away, or already past it, never gets there
+		float faceX = ballX < paddleX ? paddleX - paddleExtentX - radius : paddleX + paddleExtentX + radius;
+		if (velocityX == 0) {
+			continue;
+		}
+		float time = (faceX - ballX) / velocityX;
+		if (time < 0 || (found && time >= earliest)) {
+			continue;
+		}
+
+		// Unfold the bounces: the ball's centre goes back and forth between low and high, so its path repeats every 2 * span
+		float low = floor + radius;
+		float span = ceiling - radius - low;
+		float height = ballY + velocityY * time - low;
+		if (span > 0) {
+			float period = 2 * span;
+			height -= period * floorf(height / period);
+			if (height > span) {
+				height = period - height;
+			}
+		}
+
+		y = low + height;
+		earliest = time;
+		found = true;
+	}
+	return found;
+}
+
+template class BasicInterceptController<RuntimeGameConfig>;
+template class BasicInterceptController<ClassicCourtConfig>;
+template class BasicInterceptController<ArenaCourtConfig>;
\ No newline at end of file
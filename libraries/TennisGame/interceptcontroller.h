@@ -0,0 +1,59 @@
+#ifndef INTERCEPTCONTROLLER_H
+#define INTERCEPTCONTROLLER_H
+
+#include <stdint.h>
+#include "controller.h"
+#include "prng.h"
+
+template <class Config> class BasicGame;
+struct RuntimeGameConfig;
+
+// Seconds between looks at the ball
+#define INTERCEPT_REACTION_DELAY 0.15f
+
+// Most the paddle aims off where the ball will be, either way, in units
+#define INTERCEPT_AIM_ERROR 5.0f
+
+// Speed asked for per unit the paddle is off its target, i.e. 1 / the seconds it takes to close most of the gap
+#define INTERCEPT_GAIN 12.0f
+
+// A computer player: works out where the ball will cross its paddle and heads there through setSpeed
+// The crossing comes in closed form with the bounces off the floor and ceiling folded in, so it costs the same at any ball speed
+// Angled walls and the goal-side wall stubs are left out; the paddle just looks again after the next reaction delay
+template <class Config>
+class BasicInterceptController : public PlayerController {
+public:
+	BasicInterceptController();
+	void bind(BasicGame<Config>* _game, int _playerNum);
+	void seed(uint32_t seed);
+	void setReactionDelay(float _reactionDelay);
+	void setAimError(float _aimError);
+	void setGain(float _gain);
+
+	// Call before each advance() or tick() with the time since the last call
+	void update(float dt);
+
+	// Height the paddle's centre is headed for
+	float getTarget() const;
+
+private:
+	bool findIntercept(float& y);
+
+	BasicGame<Config>* game;
+	int playerNum;
+	float reactionDelay;
+	float aimError;
+	float gain;
+
+	// Time since the ball was last looked at, where it was headed then, and the error picked when it turned towards the paddle
+	float sinceLook;
+	float target;
+	float error;
+	bool approaching;
+	Prng random;
+};
+
+// For the host tools' Game
+typedef BasicInterceptController<RuntimeGameConfig> InterceptController;
+
+#endif
\ No newline at end of file
@@ -1,46 +1,55 @@
-#include "paddle.h"
-
-void Paddle::setup(physics::vector2d p, float length, float height) {
-	box.extents.x = length * 0.5f;
-	box.extents.y = height * 0.5f;
-	box.position.x = p.x + box.extents.x;
-	box.position.y = p.y + box.extents.y;
-	box.velocity = physics::VECTOR2D_ZERO;
-}
-
-void Paddle::setPosition(physics::vector2d position) {
-	box.position = position;
-}
-
-physics::vector2d Paddle::getPosition() const {
-	return box.position;
-}
-
-physics::vector2d Paddle::getExtents() const {
-	return box.extents;
-}
-
-void Paddle::setVelocity(physics::vector2d velocity) {
-	box.velocity.x = velocity.x;
-	box.velocity.y = velocity.y;
-}
-
-void Paddle::setVelocityX(float speed) {
-	box.velocity.x = speed;
-}
-
-void Paddle::setVelocityY(float speed) {
-	box.velocity.y = speed;
-}
-
-physics::vector2d Paddle::getVelocity() const {
-	return box.velocity;
-}
-
-void Paddle::updatePhysics(float dt) {
-	box.position += box.velocity * dt;
-}
-
-const physics::MovingBox* Paddle::getPhysicsObject() const {
-	return &box;
+#include "paddle.h"
+
+void Paddle::bind(PaddleArrays* _bodies, int _index) {
+	bodies = _bodies;
+	index = _index;
+}
+
+void Paddle::setup(physics::vector2d p, physics::scalar length, physics::scalar height) {
+	bodies->extentX[index] = length * 0.5f;
+	bodies->extentY[index] = height * 0.5f;
+	bodies->positionX[index] = p.x + bodies->extentX[index];
+	bodies->positionY[index] = p.y + bodies->extentY[index];
+	bodies->velocityX[index] = 0;
+	bodies->velocityY[index] = 0;
+	bodies->active[index] = true;
+}
+
+void Paddle::setPosition(physics::vector2d position) {
+	bodies->positionX[index] = position.x;
+	bodies->positionY[index] = position.y;
+}
+
+physics::vector2d Paddle::getPosition() const {
+	return physics::vector2d(bodies->positionX[index], bodies->positionY[index]);
+}
+
+physics::vector2d Paddle::getExtents() const {
+	return physics::vector2d(bodies->extentX[index], bodies->extentY[index]);
+}
+
+void Paddle::setVelocity(physics::vector2d velocity) {
+	bodies->velocityX[index] = velocity.x;
+	bodies->velocityY[index] = velocity.y;
+}
+
+void Paddle::setVelocityX(physics::scalar speed) {
+	bodies->velocityX[index] = speed;
+}
+
+void Paddle::setVelocityY(physics::scalar speed) {
+	bodies->velocityY[index] = speed;
+}
+
+physics::vector2d Paddle::getVelocity() const {
+	return physics::vector2d(bodies->velocityX[index], bodies->velocityY[index]);
+}
+
+void Paddle::updatePhysics(physics::scalar dt) {
+	bodies->positionX[index] += bodies->velocityX[index] * dt;
+	bodies->positionY[index] += bodies->velocityY[index] * dt;
+}
+
+physics::MovingBox Paddle::getPhysicsObject() const {
+	return bodies->getBox(index);
 }
\ No newline at end of file
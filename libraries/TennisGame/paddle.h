@@ -1,23 +1,26 @@
-#ifndef PADDLE_H
-#define PADDLE_H
-
-#include "physics\objects2d.h"
-
-class Paddle {
-public:
-	void setup(physics::vector2d p, float length, float height);
-	void setPosition(physics::vector2d position);
-	physics::vector2d getPosition() const;
-	physics::vector2d getExtents() const;
-	void setVelocity(physics::vector2d velocity);
-	void setVelocityX(float speed);
-	void setVelocityY(float speed);
-	physics::vector2d getVelocity() const;
-	void updatePhysics(float dt);
-	const physics::MovingBox* getPhysicsObject() const;
-
-private:
-	physics::MovingBox box;
-};
-
+#ifndef PADDLE_H
+#define PADDLE_H
+
+#include "entities.h"
+
+class Paddle {
+public:
+	Paddle() : bodies(0), index(0) {}
+	void bind(PaddleArrays* _bodies, int _index);
+	void setup(physics::vector2d p, physics::scalar length, physics::scalar height);
+	void setPosition(physics::vector2d position);
+	physics::vector2d getPosition() const;
+	physics::vector2d getExtents() const;
+	void setVelocity(physics::vector2d velocity);
+	void setVelocityX(physics::scalar speed);
+	void setVelocityY(physics::scalar speed);
+	physics::vector2d getVelocity() const;
+	void updatePhysics(physics::scalar dt);
+	physics::MovingBox getPhysicsObject() const;
+
+private:
+	PaddleArrays* bodies;
+	int index;
+};
+
 #endif
\ No newline at end of file
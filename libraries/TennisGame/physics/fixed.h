@@ -0,0 +1,157 @@
+#ifndef FIXED_H
+#define FIXED_H
+
+#include <stdint.h>
+#include <string.h>
+
+namespace physics {
+
+	// Q16.16 fixed-point number for targets without an FPU (the Teensy 3.1's Cortex-M4)
+	// Arithmetic and conversion from int saturate instead of wrapping so that out of range sweep times stay out of range;
+	// a float or double has to be in range before it's converted
+	class fixed {
+	public:
+		static const int FRACTIONAL_BITS = 16;
+		static const int32_t ONE = 1 << FRACTIONAL_BITS;
+
+		fixed() : raw(0) {}
+
+		fixed(int v) : raw(saturate((int64_t)v * ONE)) {}
+
+		fixed(float v) : raw((int32_t)(v * ONE + (v >= 0.0f ? 0.5f : -0.5f))) {}
+
+		fixed(double v) : raw((int32_t)(v * ONE + (v >= 0.0 ? 0.5 : -0.5))) {}
+
+		static fixed fromRaw(int32_t r) {
+			fixed f;
+			f.raw = r;
+			return f;
+		}
+
+		float toFloat() const {
+			return raw * (1.0f / ONE);
+		}
+
+		// Rounds towards negative infinity
+		int toInt() const {
+			return raw >> FRACTIONAL_BITS;
+		}
+
+		fixed operator -() const {
+			return fromRaw(saturate(-(int64_t)raw));
+		}
+
+		fixed& operator +=(fixed v) {
+			raw = saturate((int64_t)raw + v.raw);
+			return *this;
+		}
+
+		fixed& operator -=(fixed v) {
+			raw = saturate((int64_t)raw - v.raw);
+			return *this;
+		}
+
+		fixed& operator *=(fixed v) {
+			raw = saturate(((int64_t)raw * v.raw) >> FRACTIONAL_BITS);
+			return *this;
+		}
+
+		fixed& operator /=(fixed v) {
+			if (v.raw == 0) {
+				raw = raw >= 0 ? INT32_MAX : INT32_MIN;
+			} else {
+				raw = saturate(((int64_t)raw * ONE) / v.raw);
+			}
+			return *this;
+		}
+
+		friend fixed operator +(fixed a, fixed b) { return a += b; }
+		friend fixed operator -(fixed a, fixed b) { return a -= b; }
+		friend fixed operator *(fixed a, fixed b) { return a *= b; }
+		friend fixed operator /(fixed a, fixed b) { return a /= b; }
+
+		friend bool operator ==(fixed a, fixed b) { return a.raw == b.raw; }
+		friend bool operator !=(fixed a, fixed b) { return a.raw != b.raw; }
+		friend bool operator <(fixed a, fixed b) { return a.raw < b.raw; }
+		friend bool operator >(fixed a, fixed b) { return a.raw > b.raw; }
+		friend bool operator <=(fixed a, fixed b) { return a.raw <= b.raw; }
+		friend bool operator >=(fixed a, fixed b) { return a.raw >= b.raw; }
+
+		int32_t raw;
+
+	private:
+		static int32_t saturate(int64_t v) {
+			if (v > INT32_MAX) {
+				return INT32_MAX;
+			} else if (v < INT32_MIN) {
+				return INT32_MIN;
+			}
+			return (int32_t)v;
+		}
+	};
+
+	// 1 / v using a single 32-bit divide, which the Cortex-M4 does in hardware, instead of a 64-bit one
+	inline fixed reciprocal(fixed v) {
+		uint32_t magnitude = v.raw < 0 ? 0u - (uint32_t)v.raw : (uint32_t)v.raw;
+		uint32_t r = magnitude > 1 ? 0xFFFFFFFFu / magnitude : (uint32_t)INT32_MAX;
+		if (r > (uint32_t)INT32_MAX) {
+			r = INT32_MAX;
+		}
+		return fixed::fromRaw(v.raw < 0 ? -(int32_t)r : (int32_t)r);
+	}
+
+	inline float reciprocal(float v) {
+		return 1.0f / v;
+	}
+
+	// 1 / sqrt(v) for v > 0 without math.h, in 64-bit integer steps; v <= 0 gives the largest value
+	// v is scaled by a power of four into [1, 4), where Newton's method runs in Q2.30 from a guess within 19%, so four steps leave it exact to the last bit
+	inline fixed inverseSqrt(fixed v) {
+		if (v.raw <= 0) {
+			return fixed::fromRaw(INT32_MAX);
+		}
+
+		// v = m * 4^k
+		int e = (31 - __builtin_clz((uint32_t)v.raw)) - fixed::FRACTIONAL_BITS;
+		int k = e >> 1;
+		int shift = 28 - fixed::FRACTIONAL_BITS - 2 * k;
+		int64_t m = shift >= 0 ? (int64_t)v.raw << shift : (int64_t)v.raw >> -shift;
+
+		// About the geometric middle of 1 / sqrt(m): 2^-1/4 for m in [1, 2), 2^-3/4 for m in [2, 4)
+		const int64_t ONE = (int64_t)1 << 30;
+		int64_t y = (e - 2 * k) ? 638450708 : 902905651;
+		for (int i = 0; i < 4; ++i) {
+			int64_t yy = (y * y) >> 30;
+			int64_t myy = (m * yy) >> 28;
+			y = (y * (3 * ONE - myy)) >> 31;
+		}
+
+		// 1 / sqrt(v) = 2^-k / sqrt(m), rounded to Q16.16
+		int down = 30 - fixed::FRACTIONAL_BITS + k;
+		return fixed::fromRaw((int32_t)((y + ((int64_t)1 << (down - 1))) >> down));
+	}
+
+	// Same idea for float: the exponent trick for the guess, then two Newton steps, good to about five parts in a million
+	inline float inverseSqrt(float v) {
+		uint32_t bits;
+		memcpy(&bits, &v, sizeof(bits));
+		bits = 0x5F3759DFu - (bits >> 1);
+		float y;
+		memcpy(&y, &bits, sizeof(y));
+
+		y = y * (1.5f - 0.5f * v * y * y);
+		y = y * (1.5f - 0.5f * v * y * y);
+		return y;
+	}
+
+	// For drawing and anything else that has to leave the physics scalar type
+	inline float toFloat(fixed v) {
+		return v.toFloat();
+	}
+
+	inline float toFloat(float v) {
+		return v;
+	}
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,77 @@
+#ifndef MATH2D_H
+#define MATH2D_H
+
+#include "fixed.h"
+
+// Uncomment (or pass -DPHYSICS_FIXED_POINT) to run the game's physics in Q16.16 instead of float
+// #define PHYSICS_FIXED_POINT
+
+namespace physics {
+
+	#ifdef PHYSICS_FIXED_POINT
+	typedef fixed scalar;
+	#else
+	typedef float scalar;
+	#endif
+
+	#define VECTOR2D_ZERO vector2d(0, 0)
+
+	template <typename T>
+	struct basic_vector2d {
+		T x;
+		T y;
+
+		basic_vector2d() : x(0), y(0) {}
+
+		basic_vector2d(T _x, T _y) : x(_x), y(_y) {}
+
+		// Vector addition
+		basic_vector2d& operator +=(const basic_vector2d& v) {
+			x += v.x;
+			y += v.y;
+			return *this;
+		}
+
+		basic_vector2d operator +(const basic_vector2d& v) const {
+			return basic_vector2d(x + v.x, y + v.y);
+		}
+
+		// Vector Subtraction
+		basic_vector2d& operator -=(const basic_vector2d& v) {
+			x -= v.x;
+			y -= v.y;
+			return *this;
+		}
+
+		basic_vector2d operator -(const basic_vector2d& v) const {
+			return basic_vector2d(x - v.x, y - v.y);
+		}
+
+		// Scalar multiplication
+		basic_vector2d& operator *=(T s) {
+			x *= s;
+			y *= s;
+			return *this;
+		}
+
+		basic_vector2d operator *(T s) const {
+			return basic_vector2d(x * s, y * s);
+		}
+
+		// Scalar division
+		basic_vector2d& operator /=(T s) {
+			x /= s;
+			y /= s;
+			return *this;
+		}
+
+		basic_vector2d operator /(T s) const {
+			return basic_vector2d(x / s, y / s);
+		}
+	};
+
+	typedef basic_vector2d<scalar> vector2d;
+
+}
+
+#endif
\ No newline at end of file
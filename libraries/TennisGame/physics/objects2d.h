@@ -0,0 +1,58 @@
+#ifndef OBJECTS2D_H
+#define OBJECTS2D_H
+
+#include "math2d.h"
+
+namespace physics {
+
+	template <typename T>
+	struct BasicLine {
+		basic_vector2d<T> position;
+		T extent;
+	};
+
+	template <typename T>
+	struct BasicHorizontalLine : BasicLine<T> {};
+
+	template <typename T>
+	struct BasicVerticalLine : BasicLine<T> {};
+
+	template <typename T>
+	struct BasicBox {
+		basic_vector2d<T> position;
+		basic_vector2d<T> extents;
+	};
+
+	template <typename T>
+	struct BasicMovingBox : BasicBox<T> {
+		basic_vector2d<T> velocity;
+	};
+
+	// Axis-aligned min/max corners, for things that are tested far more often than they move
+	template <typename T>
+	struct BasicBounds {
+		basic_vector2d<T> min;
+		basic_vector2d<T> max;
+	};
+
+	// A line between any two points, e.g. an angled wall or a bumper; build it with makeSegment
+	// The unit normal and the bounds are worked out once, so tests and bounces never need a square root
+	template <typename T>
+	struct BasicSegment {
+		basic_vector2d<T> start;
+		basic_vector2d<T> end;
+		basic_vector2d<T> normal;
+		BasicBounds<T> bounds;
+	};
+
+	typedef BasicLine<scalar> Line;
+	typedef BasicHorizontalLine<scalar> HorizontalLine;
+	typedef BasicVerticalLine<scalar> VerticalLine;
+	typedef BasicBox<scalar> Box;
+	typedef BasicMovingBox<scalar> MovingBox;
+	typedef BasicBounds<scalar> Bounds;
+	typedef BasicSegment<scalar> Segment;
+
+}
+
+#endif
\ No newline at end of file
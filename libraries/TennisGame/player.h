@@ -1,28 +1,28 @@
-#ifndef PLAYER_H
-#define PLAYER_H
-
-#include "paddle.h"
-
-class Player {
-public:
-	Player() : active(true) {}
-	void setup(Paddle* _paddle, float _maxMovementSpeed);
-	const Paddle* getPaddle() const;
-	void update(float dt);
-
-	// Position
-	void setPosition(physics::vector2d position);
-
-	// Controls
-	void changeVerticalSpeedTo(float speed);
-	void changeHorizontalSpeedTo(float speed);
-	void stop();
-
-	bool active;
-
-private:
-	Paddle *paddle;
-	float maxMovementSpeed;
-};
-
+#ifndef PLAYER_H
+#define PLAYER_H
+
+#include "paddle.h"
+
+class Player {
+public:
+	Player() : active(true) {}
+	void setup(Paddle* _paddle, physics::scalar _maxMovementSpeed);
+	const Paddle* getPaddle() const;
+	void update(physics::scalar dt);
+
+	// Position
+	void setPosition(physics::vector2d position);
+
+	// Controls
+	void changeVerticalSpeedTo(physics::scalar speed);
+	void changeHorizontalSpeedTo(physics::scalar speed);
+	void stop();
+
+	bool active;
+
+private:
+	Paddle *paddle;
+	physics::scalar maxMovementSpeed;
+};
+
 #endif
\ No newline at end of file
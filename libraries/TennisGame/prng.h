@@ -0,0 +1,33 @@
+#ifndef PRNG_H
+#define PRNG_H
+
+#include <stdint.h>
+
+// Small xorshift generator whose whole state is one word, so it can be saved with the game and gives the same numbers on every platform
+class Prng {
+public:
+	Prng(uint32_t seed = 1) {
+		setSeed(seed);
+	}
+
+	// xorshift never leaves 0, so that seed is swapped for another
+	void setSeed(uint32_t seed) {
+		state = seed ? seed : 0x9E3779B9u;
+	}
+
+	uint32_t next() {
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		return state;
+	}
+
+	// 0 to n - 1
+	uint32_t below(uint32_t n) {
+		return (uint32_t)(((uint64_t)next() * n) >> 32);
+	}
+
+	uint32_t state;
+};
+
+#endif
\ No newline at end of file
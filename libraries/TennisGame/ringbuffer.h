@@ -0,0 +1,56 @@
+#ifndef RINGBUFFER_H
+#define RINGBUFFER_H
+
+// Fixed-size queue for one producer and one consumer, e.g. the game loop filling it and audio draining it
+// The producer only writes head and the consumer only writes tail, so neither side needs a lock
+// Capacity must be a power of two; a full buffer refuses new items rather than overwriting old ones
+template <typename T, int Capacity>
+class RingBuffer {
+public:
+	RingBuffer() : head(0), tail(0) {
+		static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "RingBuffer capacity must be a power of two");
+	}
+
+	// Producer side
+	bool push(const T& item) {
+		unsigned int h = head;
+		if (h - tail == (unsigned int)Capacity) {
+			return false;
+		}
+		items[h & (Capacity - 1)] = item;
+
+		// The item has to be in place before the consumer can see the new head
+		__sync_synchronize();
+		head = h + 1;
+		return true;
+	}
+
+	// Consumer side
+	bool pop(T& item) {
+		unsigned int t = tail;
+		if (head == t) {
+			return false;
+		}
+		item = items[t & (Capacity - 1)];
+
+		// Likewise the item has to be read before the producer can reuse its slot
+		__sync_synchronize();
+		tail = t + 1;
+		return true;
+	}
+
+	int size() const {
+		return head - tail;
+	}
+
+	bool empty() const {
+		return head == tail;
+	}
+
+private:
+	T items[Capacity];
+	volatile unsigned int head;
+	volatile unsigned int tail;
+};
+
+#endif
\ No newline at end of file
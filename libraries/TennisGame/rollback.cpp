@@ -0,0 +1,229 @@
+#include "rollback.h"
+#include <string.h>
+
+// Packet: magic, version, number of frames, first frame, frames of the receiver's input the sender has so far,
+// mask of the players the sender controls, then for each frame one float speed per player in that mask
+#define ROLLBACK_PACKET_MAGIC 0x5254
+#define ROLLBACK_PACKET_VERSION 1
+
+RollbackSession::RollbackSession(Game* _game, NetTransport* _transport, uint8_t _localPlayers, float _dt) : game(_game), transport(_transport), localPlayers(_localPlayers), dt(_dt), frame(0), remoteFrames(0), ackedFrames(0) {
+	memset(inputs, 0, sizeof(inputs));
+	memset(&stats, 0, sizeof(stats));
+
+	for (int i = 0; i < MAX_NUM_PLAYERS; ++i) {
+		game->assignController(i, &controller[i]);
+	}
+}
+
+void RollbackSession::poll() {
+	receivePackets();
+	send();
+}
+
+bool RollbackSession::advance(const float* speeds) {
+	receivePackets();
+
+	// The snapshot of the oldest frame still to be confirmed has to stay in the history, and our unacknowledged input in the ring
+	if (frame - remoteFrames >= ROLLBACK_WINDOW || frame - ackedFrames >= ROLLBACK_INPUT_FRAMES / 2) {
+		++stats.stalls;
+		send();
+		return false;
+	}
+
+	float* frameInputs = inputs[frame % ROLLBACK_INPUT_FRAMES];
+	for (int i = 0; i < MAX_NUM_PLAYERS; ++i) {
+		if (localPlayers & (1 << i)) {
+			frameInputs[i] = speeds[i];
+		}
+	}
+	if (frame >= remoteFrames) {
+		predict(frame);
+		++stats.predictedFrames;
+	}
+
+	simulate(frame);
+	++frame;
+	++stats.frames;
+
+	send();
+	return true;
+}
+
+unsigned int RollbackSession::currentFrame() const {
+	return frame;
+}
+
+unsigned int RollbackSession::confirmedFrames() const {
+	return remoteFrames < frame ? remoteFrames : frame;
+}
+
+unsigned int RollbackSession::acknowledgedFrames() const {
+	return ackedFrames;
+}
+
+const RollbackStats& RollbackSession::getStats() const {
+	return stats;
+}
+
+void RollbackSession::simulate(unsigned int f) {
+	history.record(*game);
+
+	const float* frameInputs = inputs[f % ROLLBACK_INPUT_FRAMES];
+	for (int i = 0; i < MAX_NUM_PLAYERS; ++i) {
+		controller[i].setSpeed(frameInputs[i]);
+	}
+
+	game->tick(dt);
+	if (game->winCondition()) {
+		game->resetPlayersAndBall();
+	}
+}
+
+// Remote players are guessed to carry on at their last known speed, or stand still if nothing's known yet
+void RollbackSession::predict(unsigned int f) {
+	float* frameInputs = inputs[f % ROLLBACK_INPUT_FRAMES];
+	for (int i = 0; i < MAX_NUM_PLAYERS; ++i) {
+		if (!(localPlayers & (1 << i))) {
+			frameInputs[i] = remoteFrames ? inputs[(remoteFrames - 1) % ROLLBACK_INPUT_FRAMES][i] : 0;
+		}
+	}
+}
+
+// The history holds the game as it was before each of the last frames, newest first
+void RollbackSession::rollBackTo(unsigned int f) {
+	unsigned int depth = frame - f;
+	game->restore(*history.back(depth - 1));
+	history.rewind(depth);
+
+	for (unsigned int g = f; g < frame; ++g) {
+		if (g >= remoteFrames) {
+			predict(g);
+		}
+		simulate(g);
+	}
+
+	++stats.rollbacks;
+	stats.resimulatedFrames += depth;
+	stats.lastRollbackDepth = depth;
+	if (depth > stats.maxRollbackDepth) {
+		stats.maxRollbackDepth = depth;
+	}
+}
+
+void RollbackSession::receivePackets() {
+	uint8_t packet[ROLLBACK_MAX_PACKET_SIZE];
+	int size;
+	unsigned int mismatch = frame;
+
+	while ((size = transport->receive(packet, sizeof(packet))) > 0) {
+		receive(packet, size, mismatch);
+	}
+
+	// A right guess leaves nothing to do, since later guesses were made from the same input
+	if (mismatch < frame) {
+		rollBackTo(mismatch);
+	}
+}
+
+// Takes the remote input frames that continue on from what's already known; anything past a gap waits for a resend
+// mismatch is lowered to the first frame already run on a guess that turns out wrong
+void RollbackSession::receive(const uint8_t* packet, int size, unsigned int& mismatch) {
+	uint16_t magic;
+	uint8_t version;
+	uint8_t count;
+	uint32_t first;
+	uint32_t theirRemoteFrames;
+	uint8_t players;
+
+	if (size < ROLLBACK_PACKET_HEADER_SIZE) {
+		++stats.packetsRejected;
+		return;
+	}
+	memcpy(&magic, packet, 2);
+	memcpy(&version, packet + 2, 1);
+	memcpy(&count, packet + 3, 1);
+	memcpy(&first, packet + 4, 4);
+	memcpy(&theirRemoteFrames, packet + 8, 4);
+	memcpy(&players, packet + 12, 1);
+
+	int remoteCount = 0;
+	for (int i = 0; i < MAX_NUM_PLAYERS; ++i) {
+		if (players & (1 << i)) {
+			++remoteCount;
+		}
+	}
+	if (magic != ROLLBACK_PACKET_MAGIC || version != ROLLBACK_PACKET_VERSION || (players & localPlayers) || size != ROLLBACK_PACKET_HEADER_SIZE + count * remoteCount * 4) {
+		++stats.packetsRejected;
+		return;
+	}
+	++stats.packetsReceived;
+
+	// Acknowledgements only ever move forward, whatever order packets turn up in
+	if (theirRemoteFrames > ackedFrames && theirRemoteFrames <= frame) {
+		ackedFrames = theirRemoteFrames;
+	}
+
+	const uint8_t* speeds = packet + ROLLBACK_PACKET_HEADER_SIZE;
+	for (unsigned int f = first; f < first + count; ++f, speeds += remoteCount * 4) {
+		if (f < remoteFrames) {
+			continue;
+		}
+		// The ring slot may still hold our input the remote side hasn't acknowledged
+		if (f > remoteFrames || f >= ackedFrames + ROLLBACK_INPUT_FRAMES) {
+			break;
+		}
+
+		float* frameInputs = inputs[f % ROLLBACK_INPUT_FRAMES];
+		const uint8_t* speed = speeds;
+		for (int i = 0; i < MAX_NUM_PLAYERS; ++i) {
+			if (players & (1 << i)) {
+				float actual;
+				memcpy(&actual, speed, 4);
+				speed += 4;
+
+				if (f < frame && f < mismatch && actual != frameInputs[i]) {
+					mismatch = f;
+				}
+				frameInputs[i] = actual;
+			}
+		}
+		++remoteFrames;
+	}
+}
+
+// Sends every frame of local input the remote side hasn't acknowledged, up to a packet's worth; with nothing to send it still goes out to acknowledge theirs
+void RollbackSession::send() {
+	uint8_t packet[ROLLBACK_MAX_PACKET_SIZE];
+
+	unsigned int first = ackedFrames;
+	unsigned int count = frame - first;
+	if (count > ROLLBACK_MAX_PACKET_FRAMES) {
+		count = ROLLBACK_MAX_PACKET_FRAMES;
+	}
+
+	uint16_t magic = ROLLBACK_PACKET_MAGIC;
+	uint8_t version = ROLLBACK_PACKET_VERSION;
+	uint8_t packetCount = count;
+	uint32_t packetFirst = first;
+	uint32_t packetRemoteFrames = remoteFrames;
+	memcpy(packet, &magic, 2);
+	memcpy(packet + 2, &version, 1);
+	memcpy(packet + 3, &packetCount, 1);
+	memcpy(packet + 4, &packetFirst, 4);
+	memcpy(packet + 8, &packetRemoteFrames, 4);
+	memcpy(packet + 12, &localPlayers, 1);
+
+	uint8_t* speed = packet + ROLLBACK_PACKET_HEADER_SIZE;
+	for (unsigned int f = first; f < first + count; ++f) {
+		const float* frameInputs = inputs[f % ROLLBACK_INPUT_FRAMES];
+		for (int i = 0; i < MAX_NUM_PLAYERS; ++i) {
+			if (localPlayers & (1 << i)) {
+				memcpy(speed, &frameInputs[i], 4);
+				speed += 4;
+			}
+		}
+	}
+
+	transport->send(packet, speed - packet);
+	++stats.packetsSent;
+}
\ No newline at end of file
@@ -0,0 +1,97 @@
+#ifndef ROLLBACK_H
+#define ROLLBACK_H
+
+#include <stdint.h>
+#include "game.h"
+#include "snapshothistory.h"
+
+// Most frames the session runs ahead of the remote player's last known input; it stalls rather than go further
+#define ROLLBACK_WINDOW 16
+
+// Frames of input kept for resending and re-simulating; the remote side can be up to twice the window behind on acknowledging ours
+#define ROLLBACK_INPUT_FRAMES (4 * ROLLBACK_WINDOW)
+
+// Most frames of input one packet carries
+#define ROLLBACK_MAX_PACKET_FRAMES 16
+#define ROLLBACK_PACKET_HEADER_SIZE 13
+#define ROLLBACK_MAX_PACKET_SIZE (ROLLBACK_PACKET_HEADER_SIZE + ROLLBACK_MAX_PACKET_FRAMES * MAX_NUM_PLAYERS * 4)
+
+// Moves packets between the two sides, e.g. UDP on a PC or a serial link between boards
+// Packets may be lost, repeated or reordered; neither call may block
+class NetTransport {
+public:
+	virtual void send(const void* data, int size) = 0;
+
+	// Copies the next waiting packet into buffer and returns its size, or 0 if there's none
+	virtual int receive(void* buffer, int size) = 0;
+};
+
+struct RollbackStats {
+	// Frames run for the first time, and advance() calls that ran nothing because the remote input was too far behind
+	unsigned int frames;
+	unsigned int stalls;
+
+	// Times a prediction turned out wrong, the frames run again because of it, and how far back the last and the deepest rollbacks went
+	unsigned int rollbacks;
+	unsigned int resimulatedFrames;
+	unsigned int lastRollbackDepth;
+	unsigned int maxRollbackDepth;
+
+	// Frames run on a guess of the remote input
+	unsigned int predictedFrames;
+
+	unsigned int packetsSent;
+	unsigned int packetsReceived;
+	unsigned int packetsRejected;
+};
+
+// Runs one side of a two-player match, the other side running the same on its own board or PC
+// Each side's local players are played straight away, and the remote ones are predicted to keep their last known speed
+// When the real remote input arrives and differs, the game is restored to before that frame and run forward again
+// Frames are whole game ticks followed by the round check, so both sides have to be set up and seeded the same
+class RollbackSession {
+public:
+	// localPlayers is a mask of the players this side controls; the remote side says which it controls, and a player neither side controls stands still
+	RollbackSession(Game* _game, NetTransport* _transport, uint8_t _localPlayers, float _dt);
+
+	// Reads the remote side's packets, rolling back if they show a prediction was wrong, and sends it whatever input it hasn't acknowledged
+	void poll();
+
+	// Reads packets like poll(), then runs the next frame with the local players' speeds (indexed by player number) and sends its input
+	// Returns false and runs nothing while the remote input is a whole window behind
+	bool advance(const float* speeds);
+
+	// Frames run, and how many of those have the remote input confirmed and our input acknowledged
+	unsigned int currentFrame() const;
+	unsigned int confirmedFrames() const;
+	unsigned int acknowledgedFrames() const;
+
+	const RollbackStats& getStats() const;
+
+private:
+	void simulate(unsigned int frame);
+	void predict(unsigned int frame);
+	void rollBackTo(unsigned int frame);
+	void receivePackets();
+	void receive(const uint8_t* packet, int size, unsigned int& mismatch);
+	void send();
+
+	Game* game;
+	NetTransport* transport;
+	uint8_t localPlayers;
+	float dt;
+
+	PlayerController controller[MAX_NUM_PLAYERS];
+	SnapshotHistory<ROLLBACK_WINDOW> history;
+
+	// Speeds each frame was (or will be) run with, local and remote
+	float inputs[ROLLBACK_INPUT_FRAMES][MAX_NUM_PLAYERS];
+
+	unsigned int frame;
+	unsigned int remoteFrames;
+	unsigned int ackedFrames;
+
+	RollbackStats stats;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,69 @@
+#include "scenemachine.h"
+
+SceneMachine::SceneMachine() : current(NO_SCENE), pending(NO_SCENE), time(0) {
+	for (int i = 0; i < MAX_NUM_SCENES; ++i) {
+		scenes[i].enter = 0;
+		scenes[i].update = 0;
+		scenes[i].duration = 0;
+		scenes[i].next = NO_SCENE;
+	}
+}
+
+void SceneMachine::addScene(int scene, SceneEnterFunction enter, SceneUpdateFunction update, float duration, int next) {
+	if (scene < 0 || scene >= MAX_NUM_SCENES) {
+		return;
+	}
+	scenes[scene].enter = enter;
+	scenes[scene].update = update;
+	scenes[scene].duration = duration;
+	scenes[scene].next = next;
+}
+
+void SceneMachine::change(int scene) {
+	if (scene >= 0 && scene < MAX_NUM_SCENES) {
+		pending = scene;
+	}
+}
+
+void SceneMachine::update(float dt) {
+	enterPending();
+	if (current == NO_SCENE) {
+		return;
+	}
+
+	time += dt;
+	const Scene& scene = scenes[current];
+	if (scene.update) {
+		scene.update(dt);
+	}
+
+	// Time past the end of a timed scene is carried into the next one, so a chain of them doesn't drift by a frame each
+	if (pending == NO_SCENE && scene.duration > 0 && time >= scene.duration && scene.next != NO_SCENE) {
+		float carried = time - scene.duration;
+		pending = scene.next;
+		enterPending();
+		time = carried;
+	} else {
+		enterPending();
+	}
+}
+
+int SceneMachine::currentScene() const {
+	return current;
+}
+
+float SceneMachine::timeInScene() const {
+	return time;
+}
+
+void SceneMachine::enterPending() {
+	// An enter function may itself change scene; give up after every scene has had a turn rather than loop forever
+	for (int i = 0; i < MAX_NUM_SCENES && pending != NO_SCENE; ++i) {
+		current = pending;
+		pending = NO_SCENE;
+		time = 0;
+		if (scenes[current].enter) {
+			scenes[current].enter();
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,50 @@
+#ifndef SCENEMACHINE_H
+#define SCENEMACHINE_H
+
+// Most scenes a machine can hold; they live in a fixed table, so nothing is allocated
+#define MAX_NUM_SCENES 8
+
+// Scene number for "none", as a next scene or before the first change()
+#define NO_SCENE -1
+
+// Called once on entering a scene
+typedef void (*SceneEnterFunction)();
+
+// Called every frame while a scene is current, with the time since the last frame
+typedef void (*SceneUpdateFunction)(float dt);
+
+struct Scene {
+	SceneEnterFunction enter;
+	SceneUpdateFunction update;
+
+	// A scene with a duration moves on to next by itself once that much time has been spent in it; 0 waits for change()
+	float duration;
+	int next;
+};
+
+// Runs one scene at a time and moves between them a frame at a time instead of blocking,
+// so whatever the caller does around update() (input, drawing, sound) keeps going through transitions
+class SceneMachine {
+public:
+	SceneMachine();
+	void addScene(int scene, SceneEnterFunction enter, SceneUpdateFunction update, float duration = 0, int next = NO_SCENE);
+
+	// Switches scene before the next update; from inside a scene's functions it takes effect as soon as they return
+	void change(int scene);
+
+	// Enters any scene asked for, runs the current scene for dt and follows timed transitions
+	void update(float dt);
+
+	int currentScene() const;
+	float timeInScene() const;
+
+private:
+	void enterPending();
+
+	Scene scenes[MAX_NUM_SCENES];
+	int current;
+	int pending;
+	float time;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,116 @@
+#include "scheduler.h"
+#include <string.h>
+
+Scheduler::Scheduler(SchedulerClock _clock) : clock(_clock), numTasks(0) {
+}
+
+int Scheduler::addTask(TaskFunction function, unsigned long period, unsigned long deadline) {
+	if (numTasks >= MAX_NUM_TASKS || period == 0) {
+		return -1;
+	}
+	Task& task = tasks[numTasks];
+	task.function = function;
+	task.period = period;
+	task.deadline = deadline ? deadline : period;
+	task.release = clock();
+	task.lastStart = task.release;
+	task.started = false;
+	task.enabled = true;
+	memset(&task.stats, 0, sizeof(task.stats));
+	return numTasks++;
+}
+
+void Scheduler::setEnabled(int task, bool enabled) {
+	if (task < 0 || task >= numTasks || tasks[task].enabled == enabled) {
+		return;
+	}
+
+	// Starts over from now, rather than owing every period it was off for
+	tasks[task].enabled = enabled;
+	tasks[task].release = clock();
+	tasks[task].started = false;
+}
+
+bool Scheduler::runNext() {
+	const unsigned long now = clock();
+
+	// Earliest deadline first among the due tasks; the differences keep this right across the clock wrapping
+	int next = -1;
+	unsigned long nextDeadline = 0;
+	for (int i = 0; i < numTasks; ++i) {
+		const Task& task = tasks[i];
+		if (!task.enabled || (long)(now - task.release) < 0) {
+			continue;
+		}
+		unsigned long deadline = task.release + task.deadline;
+		if (next < 0 || (long)(deadline - nextDeadline) < 0) {
+			next = i;
+			nextDeadline = deadline;
+		}
+	}
+	if (next < 0) {
+		return false;
+	}
+
+	Task& task = tasks[next];
+	float dt = (task.started ? now - task.lastStart : task.period) / 1000000.0f;
+	task.lastStart = now;
+	task.started = true;
+	task.function(dt);
+	const unsigned long end = clock();
+
+	TaskStats& stats = task.stats;
+	++stats.runs;
+	stats.lastRuntime = end - now;
+	stats.totalRuntime += stats.lastRuntime;
+	if (stats.lastRuntime > stats.maxRuntime) {
+		stats.maxRuntime = stats.lastRuntime;
+	}
+	if (now - task.release > stats.maxLateness) {
+		stats.maxLateness = now - task.release;
+	}
+	if ((long)(end - nextDeadline) > 0) {
+		++stats.misses;
+	}
+
+	// A task that has fallen a whole period or more behind drops the periods it can't make, instead of running back to back to catch up
+	task.release += task.period;
+	if ((long)(end - task.release) >= (long)task.period) {
+		unsigned long behind = (end - task.release) / task.period;
+		task.release += behind * task.period;
+		stats.skipped += behind;
+	}
+	return true;
+}
+
+unsigned long Scheduler::idleTime() {
+	const unsigned long now = clock();
+	unsigned long idle = (unsigned long)-1;
+	for (int i = 0; i < numTasks; ++i) {
+		if (!tasks[i].enabled) {
+			continue;
+		}
+		long until = (long)(tasks[i].release - now);
+		if (until <= 0) {
+			return 0;
+		}
+		if ((unsigned long)until < idle) {
+			idle = until;
+		}
+	}
+	return idle;
+}
+
+int Scheduler::numberOfTasks() const {
+	return numTasks;
+}
+
+const TaskStats& Scheduler::getStats(int task) const {
+	return tasks[task].stats;
+}
+
+void Scheduler::resetStats() {
+	for (int i = 0; i < numTasks; ++i) {
+		memset(&tasks[i].stats, 0, sizeof(tasks[i].stats));
+	}
+}
\ No newline at end of file
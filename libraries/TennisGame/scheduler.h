@@ -0,0 +1,65 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+// Most tasks a scheduler can hold; they live in a fixed table, so nothing is allocated
+#define MAX_NUM_TASKS 8
+
+// Returns the time in microseconds, wrapping like micros() does; the sketch passes micros, host tools a clock of their own
+typedef unsigned long (*SchedulerClock)();
+
+// Called once per period with the seconds since the task last ran
+typedef void (*TaskFunction)(float dt);
+
+struct TaskStats {
+	unsigned long runs;
+
+	// Runs that finished after their deadline, and periods dropped altogether because the task was still behind
+	unsigned long misses;
+	unsigned long skipped;
+
+	// Microseconds spent in the task, and from when it was due to when it started
+	unsigned long lastRuntime;
+	unsigned long maxRuntime;
+	unsigned long long totalRuntime;
+	unsigned long maxLateness;
+};
+
+// Runs tasks at their own rates from one loop, one task at a time and each to completion.
+// A task is due every period, drift-free, and should finish within its deadline of becoming due;
+// when several are due the one whose deadline comes first runs, ties going to the task added first.
+class Scheduler {
+public:
+	Scheduler(SchedulerClock _clock);
+
+	// Periods and deadlines are in microseconds; a deadline of 0 is the period. Returns the task's number, or -1 when full
+	int addTask(TaskFunction function, unsigned long period, unsigned long deadline = 0);
+	void setEnabled(int task, bool enabled);
+
+	// Runs the most urgent due task, if any; call it as often as possible. Returns whether a task ran
+	bool runNext();
+
+	// Microseconds until the next task is due, 0 when one already is
+	unsigned long idleTime();
+
+	int numberOfTasks() const;
+	const TaskStats& getStats(int task) const;
+	void resetStats();
+
+private:
+	struct Task {
+		TaskFunction function;
+		unsigned long period;
+		unsigned long deadline;
+		unsigned long release;
+		unsigned long lastStart;
+		bool started;
+		bool enabled;
+		TaskStats stats;
+	};
+
+	SchedulerClock clock;
+	Task tasks[MAX_NUM_TASKS];
+	int numTasks;
+};
+
+#endif
\ No newline at end of file
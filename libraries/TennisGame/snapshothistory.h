@@ -0,0 +1,62 @@
+#ifndef SNAPSHOTHISTORY_H
+#define SNAPSHOTHISTORY_H
+
+#include "game.h"
+
+// The last Capacity snapshots of a game in a fixed block of sizeof(GameSnapshot) * Capacity bytes
+// Recording over a full history replaces the oldest snapshot
+template <int Capacity>
+class SnapshotHistory {
+public:
+	SnapshotHistory() : newest(Capacity - 1), count(0) {}
+
+	void clear() {
+		count = 0;
+	}
+
+	void record(const Game& game) {
+		newest = (newest + 1) % Capacity;
+		game.save(snapshots[newest]);
+		if (count < Capacity) {
+			++count;
+		}
+	}
+
+	int size() const {
+		return count;
+	}
+
+	// 0 is the newest snapshot; returns 0 if fewer than ago + 1 are kept
+	const GameSnapshot* back(int ago) const {
+		if (ago < 0 || ago >= count) {
+			return 0;
+		}
+		return &snapshots[(newest - ago + Capacity) % Capacity];
+	}
+
+	// How many snapshots ago the game was saved at the end of the given tick, or -1 if that's no longer kept
+	int find(unsigned int tick) const {
+		for (int ago = 0; ago < count; ++ago) {
+			if (back(ago)->stats.tick == tick) {
+				return ago;
+			}
+		}
+		return -1;
+	}
+
+	// Drops the ago newest snapshots, so the one restored from becomes the newest and the game can be recorded on from there
+	void rewind(int ago) {
+		if (ago > count) {
+			ago = count;
+		}
+		newest = (newest - ago + Capacity) % Capacity;
+		count -= ago;
+	}
+
+private:
+	GameSnapshot snapshots[Capacity];
+	int newest;
+	int count;
+};
+
+#endif
\ No newline at end of file
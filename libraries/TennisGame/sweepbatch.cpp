@@ -0,0 +1,266 @@
+#include "sweepbatch.h"
+
+// Float host builds use SSE or AVX unless PHYSICS_NO_SIMD is defined; everything else, the Teensy included, takes the unrolled scalar path
+#if !defined(PHYSICS_NO_SIMD) && (defined(__SSE2__) || defined(__AVX__))
+#define SWEEP_BATCH_SIMD
+#include <immintrin.h>
+#endif
+
+namespace physics {
+
+	namespace {
+
+		// Both scalars put "never" at time 2, after the end of the sweep, and "always" at -1
+		template <typename T>
+		inline T select(bool condition, T a, T b) {
+			return condition ? a : b;
+		}
+
+		// Entry and exit time of one target on one axis
+		// An axis the box doesn't move along is either always or never overlapping, decided without dividing
+		template <typename T>
+		inline void axisInterval(T boxMin, T boxMax, T targetMin, T targetMax, T inverse, bool still, T& enter, T& exit) {
+			T t1 = (boxMin - targetMax) * inverse;
+			T t2 = (boxMax - targetMin) * inverse;
+			bool overlap = (boxMin <= targetMax) & (targetMin <= boxMax);
+			bool ordered = t1 < t2;
+
+			enter = select(still, select(overlap, T(-1), T(2)), select(ordered, t1, t2));
+			exit = select(still, select(overlap, T(2), T(-1)), select(ordered, t2, t1));
+		}
+
+		template <typename T>
+		struct ScalarSweep {
+			T boxMinX, boxMinY, boxMaxX, boxMaxY;
+			T inverseX, inverseY;
+			bool stillX, stillY;
+			const T* minX;
+			const T* minY;
+			const T* maxX;
+			const T* maxY;
+			uint32_t mask;
+
+			// Keeps the earliest hit so far in bestTime and bestIndex, with selects rather than branches
+			inline void lane(int i, T& bestTime, int& bestIndex) const {
+				T enterX, exitX, enterY, exitY;
+				axisInterval(boxMinX, boxMaxX, minX[i], maxX[i], inverseX, stillX, enterX, exitX);
+				axisInterval(boxMinY, boxMaxY, minY[i], maxY[i], inverseY, stillY, enterY, exitY);
+
+				T enter = select(enterX > enterY, enterX, enterY);
+				enter = select(enter > T(0), enter, T(0));
+				T exit = select(exitX < exitY, exitX, exitY);
+				exit = select(exit < T(1), exit, T(1));
+
+				bool better = (((mask >> i) & 1u) != 0) & (enter <= exit) & (enter < bestTime);
+				bestTime = select(better, enter, bestTime);
+				bestIndex = select(better, i, bestIndex);
+			}
+		};
+
+		// Integer selects by masking, which compilers otherwise turn back into jumps on whether the targets overlap
+		inline int64_t select(bool condition, int64_t a, int64_t b) {
+			return b ^ ((a ^ b) & -(int64_t)condition);
+		}
+
+		inline int select(bool condition, int a, int b) {
+			return b ^ ((a ^ b) & -(int)condition);
+		}
+
+		// Q16.16 works the times out as 64-bit raw values instead, since every fixed multiply saturates with a branch.
+		// Far out of range times come up whenever the step is short, but a time is only kept once it's clamped into [0, 1],
+		// where it fits a fixed again, so nothing has to saturate along the way.
+		inline void axisInterval(int64_t boxMin, int64_t boxMax, int64_t targetMin, int64_t targetMax, int64_t inverse, bool still, int64_t& enter, int64_t& exit) {
+			int64_t t1 = ((boxMin - targetMax) * inverse) >> fixed::FRACTIONAL_BITS;
+			int64_t t2 = ((boxMax - targetMin) * inverse) >> fixed::FRACTIONAL_BITS;
+			bool overlap = (boxMin <= targetMax) & (targetMin <= boxMax);
+			bool ordered = t1 < t2;
+			int64_t always = -fixed::ONE;
+			int64_t never = 2 * fixed::ONE;
+
+			enter = select(still, select(overlap, always, never), select(ordered, t1, t2));
+			exit = select(still, select(overlap, never, always), select(ordered, t2, t1));
+		}
+
+		template <>
+		inline void ScalarSweep<fixed>::lane(int i, fixed& bestTime, int& bestIndex) const {
+			int64_t enterX, exitX, enterY, exitY;
+			axisInterval(boxMinX.raw, boxMaxX.raw, minX[i].raw, maxX[i].raw, inverseX.raw, stillX, enterX, exitX);
+			axisInterval(boxMinY.raw, boxMaxY.raw, minY[i].raw, maxY[i].raw, inverseY.raw, stillY, enterY, exitY);
+
+			int64_t enter = select(enterX > enterY, enterX, enterY);
+			enter = select(enter > 0, enter, (int64_t)0);
+			int64_t exit = select(exitX < exitY, exitX, exitY);
+			exit = select(exit < fixed::ONE, exit, (int64_t)fixed::ONE);
+
+			bool better = (((mask >> i) & 1u) != 0) & (enter <= exit) & (enter < bestTime.raw);
+			bestTime = fixed::fromRaw((int32_t)select(better, enter, (int64_t)bestTime.raw));
+			bestIndex = select(better, i, bestIndex);
+		}
+
+		// Four targets per iteration; on the Teensy this keeps the loop overhead off the 32-bit multiplies
+		template <typename T>
+		int sweepTargets(T dt, const BasicMovingBox<T>& box, const T* minX, const T* minY, const T* maxX, const T* maxY, int paddedCount, uint32_t mask, T& normalizedTimeOfCollision) {
+			// Solved in the box's frame of reference, where the targets move the other way
+			basic_vector2d<T> da = box.velocity * dt;
+			basic_vector2d<T> d = basic_vector2d<T>(-da.x, -da.y);
+
+			ScalarSweep<T> sweep;
+			sweep.boxMinX = box.position.x - box.extents.x;
+			sweep.boxMinY = box.position.y - box.extents.y;
+			sweep.boxMaxX = box.position.x + box.extents.x;
+			sweep.boxMaxY = box.position.y + box.extents.y;
+			sweep.stillX = d.x == T(0);
+			sweep.stillY = d.y == T(0);
+			sweep.inverseX = sweep.stillX ? T(0) : reciprocal(d.x);
+			sweep.inverseY = sweep.stillY ? T(0) : reciprocal(d.y);
+			sweep.minX = minX;
+			sweep.minY = minY;
+			sweep.maxX = maxX;
+			sweep.maxY = maxY;
+			sweep.mask = mask;
+
+			T bestTime = T(2);
+			int bestIndex = -1;
+			for (int i = 0; i < paddedCount; i += 4) {
+				sweep.lane(i, bestTime, bestIndex);
+				sweep.lane(i + 1, bestTime, bestIndex);
+				sweep.lane(i + 2, bestTime, bestIndex);
+				sweep.lane(i + 3, bestTime, bestIndex);
+			}
+
+			if (bestIndex >= 0) {
+				normalizedTimeOfCollision = bestTime;
+			}
+			return bestIndex;
+		}
+
+		#ifdef SWEEP_BATCH_SIMD
+
+		#ifdef __AVX__
+		typedef __m256 lanes;
+		const int LANE_COUNT = 8;
+		inline lanes lanesSet(float v) { return _mm256_set1_ps(v); }
+		inline lanes lanesLoad(const float* p) { return _mm256_loadu_ps(p); }
+		inline lanes lanesLoadMask(const uint32_t* p) { return _mm256_castsi256_ps(_mm256_loadu_si256((const __m256i*)p)); }
+		inline void lanesStore(float* p, lanes v) { _mm256_storeu_ps(p, v); }
+		inline lanes lanesAdd(lanes a, lanes b) { return _mm256_add_ps(a, b); }
+		inline lanes lanesSub(lanes a, lanes b) { return _mm256_sub_ps(a, b); }
+		inline lanes lanesMul(lanes a, lanes b) { return _mm256_mul_ps(a, b); }
+		inline lanes lanesMin(lanes a, lanes b) { return _mm256_min_ps(a, b); }
+		inline lanes lanesMax(lanes a, lanes b) { return _mm256_max_ps(a, b); }
+		inline lanes lanesAnd(lanes a, lanes b) { return _mm256_and_ps(a, b); }
+		inline lanes lanesLessEqual(lanes a, lanes b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+		inline lanes lanesLess(lanes a, lanes b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+		inline lanes lanesSelect(lanes condition, lanes a, lanes b) { return _mm256_blendv_ps(b, a, condition); }
+		inline lanes lanesIndices() { return _mm256_setr_ps(0, 1, 2, 3, 4, 5, 6, 7); }
+		#else
+		typedef __m128 lanes;
+		const int LANE_COUNT = 4;
+		inline lanes lanesSet(float v) { return _mm_set1_ps(v); }
+		inline lanes lanesLoad(const float* p) { return _mm_loadu_ps(p); }
+		inline lanes lanesLoadMask(const uint32_t* p) { return _mm_castsi128_ps(_mm_loadu_si128((const __m128i*)p)); }
+		inline void lanesStore(float* p, lanes v) { _mm_storeu_ps(p, v); }
+		inline lanes lanesAdd(lanes a, lanes b) { return _mm_add_ps(a, b); }
+		inline lanes lanesSub(lanes a, lanes b) { return _mm_sub_ps(a, b); }
+		inline lanes lanesMul(lanes a, lanes b) { return _mm_mul_ps(a, b); }
+		inline lanes lanesMin(lanes a, lanes b) { return _mm_min_ps(a, b); }
+		inline lanes lanesMax(lanes a, lanes b) { return _mm_max_ps(a, b); }
+		inline lanes lanesAnd(lanes a, lanes b) { return _mm_and_ps(a, b); }
+		inline lanes lanesLessEqual(lanes a, lanes b) { return _mm_cmple_ps(a, b); }
+		inline lanes lanesLess(lanes a, lanes b) { return _mm_cmplt_ps(a, b); }
+		inline lanes lanesSelect(lanes condition, lanes a, lanes b) { return _mm_or_ps(_mm_and_ps(condition, a), _mm_andnot_ps(condition, b)); }
+		inline lanes lanesIndices() { return _mm_setr_ps(0, 1, 2, 3); }
+		#endif
+
+		// Same steps as axisInterval, LANE_COUNT targets at a time
+		inline void axisInterval(lanes boxMin, lanes boxMax, lanes targetMin, lanes targetMax, lanes inverse, lanes still, lanes& enter, lanes& exit) {
+			lanes t1 = lanesMul(lanesSub(boxMin, targetMax), inverse);
+			lanes t2 = lanesMul(lanesSub(boxMax, targetMin), inverse);
+			lanes overlap = lanesAnd(lanesLessEqual(boxMin, targetMax), lanesLessEqual(targetMin, boxMax));
+			lanes always = lanesSet(-1.0f);
+			lanes never = lanesSet(2.0f);
+
+			enter = lanesSelect(still, lanesSelect(overlap, always, never), lanesMin(t1, t2));
+			exit = lanesSelect(still, lanesSelect(overlap, never, always), lanesMax(t1, t2));
+		}
+
+		int sweepTargets(float dt, const BasicMovingBox<float>& box, const float* minX, const float* minY, const float* maxX, const float* maxY, int paddedCount, uint32_t mask, float& normalizedTimeOfCollision) {
+			// Solved in the box's frame of reference, where the targets move the other way
+			basic_vector2d<float> da = box.velocity * dt;
+			basic_vector2d<float> d = basic_vector2d<float>(-da.x, -da.y);
+
+			bool stillX = d.x == 0.0f;
+			bool stillY = d.y == 0.0f;
+			lanes inverseX = lanesSet(stillX ? 0.0f : 1.0f / d.x);
+			lanes inverseY = lanesSet(stillY ? 0.0f : 1.0f / d.y);
+			lanes stillMaskX = lanesLessEqual(lanesSet(stillX ? 0.0f : 1.0f), lanesSet(0.0f));
+			lanes stillMaskY = lanesLessEqual(lanesSet(stillY ? 0.0f : 1.0f), lanesSet(0.0f));
+
+			lanes boxMinX = lanesSet(box.position.x - box.extents.x);
+			lanes boxMinY = lanesSet(box.position.y - box.extents.y);
+			lanes boxMaxX = lanesSet(box.position.x + box.extents.x);
+			lanes boxMaxY = lanesSet(box.position.y + box.extents.y);
+
+			// The mask, one all-ones or all-zeros word per target
+			uint32_t selected[32];
+			for (int i = 0; i < paddedCount; ++i) {
+				selected[i] = 0u - ((mask >> i) & 1u);
+			}
+
+			lanes zero = lanesSet(0.0f);
+			lanes one = lanesSet(1.0f);
+			lanes bestTime = lanesSet(2.0f);
+			lanes bestIndex = lanesSet(-1.0f);
+			lanes index = lanesIndices();
+			lanes step = lanesSet((float)LANE_COUNT);
+
+			for (int i = 0; i < paddedCount; i += LANE_COUNT) {
+				lanes enterX, exitX, enterY, exitY;
+				axisInterval(boxMinX, boxMaxX, lanesLoad(minX + i), lanesLoad(maxX + i), inverseX, stillMaskX, enterX, exitX);
+				axisInterval(boxMinY, boxMaxY, lanesLoad(minY + i), lanesLoad(maxY + i), inverseY, stillMaskY, enterY, exitY);
+
+				lanes enter = lanesMax(lanesMax(enterX, enterY), zero);
+				lanes exit = lanesMin(lanesMin(exitX, exitY), one);
+
+				lanes better = lanesAnd(lanesAnd(lanesLoadMask(selected + i), lanesLessEqual(enter, exit)), lanesLess(enter, bestTime));
+				bestTime = lanesSelect(better, enter, bestTime);
+				bestIndex = lanesSelect(better, index, bestIndex);
+				index = lanesAdd(index, step);
+			}
+
+			// Each lane holds the earliest of the targets it saw; the lowest index wins a tie, as in the scalar path
+			float times[LANE_COUNT];
+			float indices[LANE_COUNT];
+			lanesStore(times, bestTime);
+			lanesStore(indices, bestIndex);
+
+			float time = 2.0f;
+			int best = -1;
+			for (int i = 0; i < LANE_COUNT; ++i) {
+				int laneIndex = (int)indices[i];
+				if (laneIndex >= 0 && (times[i] < time || (times[i] == time && laneIndex < best))) {
+					time = times[i];
+					best = laneIndex;
+				}
+			}
+
+			if (best >= 0) {
+				normalizedTimeOfCollision = time;
+			}
+			return best;
+		}
+
+		#endif
+	}
+
+	template <typename T>
+	int sweepBatch(T dt, const BasicMovingBox<T>& box, const T* minX, const T* minY, const T* maxX, const T* maxY, int paddedCount, uint32_t mask, T& normalizedTimeOfCollision) {
+		return sweepTargets(dt, box, minX, minY, maxX, maxY, paddedCount, mask, normalizedTimeOfCollision);
+	}
+
+	#define PHYSICS_INSTANTIATE_SWEEP_BATCH(T) \
+		template int sweepBatch<T>(T, const BasicMovingBox<T>&, const T*, const T*, const T*, const T*, int, uint32_t, T&);
+
+	PHYSICS_INSTANTIATE_SWEEP_BATCH(float)
+	PHYSICS_INSTANTIATE_SWEEP_BATCH(fixed)
+}
\ No newline at end of file
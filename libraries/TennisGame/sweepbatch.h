@@ -0,0 +1,66 @@
+#ifndef SWEEPBATCH_H
+#define SWEEPBATCH_H
+
+#include <stdint.h>
+#include "physics/objects2d.h"
+
+// Targets are processed this many at a time; 8 floats fill an AVX register
+#define SWEEP_BATCH_WIDTH 8
+
+namespace physics {
+
+	// Still boxes stored as a structure of arrays for sweepBatch
+	// Arrays are padded to a whole number of batches so the kernel never needs a tail loop
+	template <typename T, int Capacity>
+	struct BasicSweepTargets {
+		enum {
+			PaddedCapacity = (Capacity + SWEEP_BATCH_WIDTH - 1) / SWEEP_BATCH_WIDTH * SWEEP_BATCH_WIDTH
+		};
+
+		T minX[PaddedCapacity];
+		T minY[PaddedCapacity];
+		T maxX[PaddedCapacity];
+		T maxY[PaddedCapacity];
+		int count;
+
+		BasicSweepTargets() {
+			clear();
+		}
+
+		void clear() {
+			count = 0;
+			for (int i = 0; i < PaddedCapacity; ++i) {
+				minX[i] = minY[i] = maxX[i] = maxY[i] = T(0);
+			}
+		}
+
+		// Returns the target index, or -1 if full
+		int add(const BasicBounds<T>& bounds) {
+			if (count >= Capacity) {
+				return -1;
+			}
+			minX[count] = bounds.min.x;
+			minY[count] = bounds.min.y;
+			maxX[count] = bounds.max.x;
+			maxY[count] = bounds.max.y;
+			return count++;
+		}
+	};
+
+	// Sweeps one moving box against up to 32 still targets at once and returns the index of the earliest hit, or -1
+	// Only targets whose bit is set in mask are considered; ties go to the lowest index
+	// Every target costs the same whatever is hit: there are no per-target branches, Q16.16 works in 64 bits so its
+	// multiplies don't saturate per target, and float host builds use SSE or AVX
+	// Touching at the start is a hit at time 0, the same as movingBoxCollidesWithStatic<STATIC_BOX>
+	template <typename T>
+	int sweepBatch(T dt, const BasicMovingBox<T>& box, const T* minX, const T* minY, const T* maxX, const T* maxY, int paddedCount, uint32_t mask, T& normalizedTimeOfCollision);
+
+	template <typename T, int Capacity>
+	inline int sweepBatch(T dt, const BasicMovingBox<T>& box, const BasicSweepTargets<T, Capacity>& targets, uint32_t mask, T& normalizedTimeOfCollision) {
+		static_assert(Capacity <= 32, "sweepBatch selects targets with a 32-bit mask");
+		int paddedCount = (targets.count + SWEEP_BATCH_WIDTH - 1) / SWEEP_BATCH_WIDTH * SWEEP_BATCH_WIDTH;
+		return sweepBatch(dt, box, targets.minX, targets.minY, targets.maxX, targets.maxY, paddedCount, mask & ((targets.count < 32 ? (1ul << targets.count) : 0ul) - 1), normalizedTimeOfCollision);
+	}
+}
+
+#endif
\ No newline at end of file
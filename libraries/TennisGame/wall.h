@@ -1,30 +1,30 @@
-#ifndef WALL_H
-#define WALL_H
-
-#include "physics\objects2d.h"
-
-class HorizontalWall {
-public:
-	void setup(physics::vector2d p, float length);
-	physics::vector2d getPosition() const;
-	float getExtent() const;
-	physics::vector2d getExtents() const;
-	const physics::HorizontalLine* getPhysicsObject() const;
-
-private:
-	physics::HorizontalLine line;
-};
-
-class VerticalWall {
-public:
-	void setup(physics::vector2d p, float height);
-	physics::vector2d getPosition() const;
-	float getExtent() const;
-	physics::vector2d getExtents() const;
-	const physics::VerticalLine* getPhysicsObject() const;
-
-private:
-	physics::VerticalLine line;
-};
-
+#ifndef WALL_H
+#define WALL_H
+
+#include "physics/objects2d.h"
+
+class HorizontalWall {
+public:
+	void setup(physics::vector2d p, physics::scalar length);
+	physics::vector2d getPosition() const;
+	physics::scalar getExtent() const;
+	physics::vector2d getExtents() const;
+	const physics::HorizontalLine* getPhysicsObject() const;
+
+private:
+	physics::HorizontalLine line;
+};
+
+class VerticalWall {
+public:
+	void setup(physics::vector2d p, physics::scalar height);
+	physics::vector2d getPosition() const;
+	physics::scalar getExtent() const;
+	physics::vector2d getExtents() const;
+	const physics::VerticalLine* getPhysicsObject() const;
+
+private:
+	physics::VerticalLine line;
+};
+
 #endif
\ No newline at end of file